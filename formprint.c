@@ -6,57 +6,147 @@
  */
 
 #include	"hal_config.h"
+#include	"hal_variables.h"
 #include 	"formprint.h"
 #include	"printfx.h"
 #include	"x_terminal.h"
 
+#include	<string.h>
+
 #define	formMASK(f,m,p,a)	(((f & m) >> p) + a)
 
+// Rendering of the DATE/TIME prefix for the current second, protected by printfx_lock()
+static	struct {
+	seconds_t	Seconds ;
+	uint32_t	Flags ;
+	uint8_t		Len ;
+	char		Buf[formLOG_STAMP_SIZE] ;
+} sLogStamp ;
+
+typedef	struct formlog_t {								// vLogPrintf() record staging
+	int			Used ;
+	char		Buf[formLOG_BUF_SIZE] ;
+} formlog_t ;
+DUMB_STATIC_ASSERT(formLOG_BUF_SIZE >= (formLOG_PRE_SIZE + formLOG_POST_SIZE)) ;
+
 /*
- *	vLogPrePend - process all options to prepend info
- *	\brief	prepend all the characters as per the flag in the specific sequence
- *	\param	pCB - pointer to the circular buffer control structure
+ *	xLogPrePend - render all options to prepend info
+ *	\brief	render all the characters as per the flag in the specific sequence, must hold printfx_lock()
+ *	\param	pBuf - buffer of at least formLOG_PRE_SIZE characters
  * 			flag	- control buffer formatting flag
- *	\return	none
+ *	\return	number of characters rendered
  */
-void	vLogPrePend(uint32_t flag) {
-	if (flag & FLAG_CB_FG_MASK)		vANSIattrib(formMASK(flag, FLAG_CB_FG_MASK, 29, 30), 0) ;
-	if (flag & FLAG_CB_BG_MASK)		vANSIattrib(formMASK(flag, FLAG_CB_BG_MASK, 25, 40), 0) ;
-    if (flag & FLAG_CB_PRE_CL)		putcx(CHR_LF, configSTDIO_UART_CHAN) ;
-    if (flag & FLAG_CB_PRE_SPC)    	putcx(CHR_SPACE, configSTDIO_UART_CHAN) ;
+static	int	xLogPrePend(char * pBuf, uint32_t flag) {
+	char * pNow = pBuf ;
+	if (flag & FLAG_CB_FG_MASK)		pNow = pcANSIattrib(pNow, formMASK(flag, FLAG_CB_FG_MASK, 29, 30), 0) ;
+	if (flag & FLAG_CB_BG_MASK)		pNow = pcANSIattrib(pNow, formMASK(flag, FLAG_CB_BG_MASK, 25, 40), 0) ;
+	if (flag & FLAG_CB_PRE_CL)		*pNow++ = CHR_LF ;
+	if (flag & FLAG_CB_PRE_UPSECS)	pNow += snprintfx(pNow, formLOG_STAMP_SIZE, "%!.R ", RunTime) ;
+	uint32_t Type = flag & (FLAG_CB_PRE_DATE | FLAG_CB_PRE_TIME) ;
+	if (Type) {
+		TSZ_t	sNow = sTSZ ;
+		seconds_t Seconds = xTimeStampAsSeconds(sNow.usecs) ;
+		if (sLogStamp.Seconds != Seconds || sLogStamp.Flags != Type) {	// new second, render again
+			sLogStamp.Len = snprintfx(sLogStamp.Buf, sizeof(sLogStamp.Buf),
+				(Type == FLAG_CB_PRE_DATE) ? "%D " : (Type == FLAG_CB_PRE_TIME) ? "%T " : "%Z ", &sNow) ;
+			sLogStamp.Seconds = Seconds ;
+			sLogStamp.Flags = Type ;
+		}
+		memcpy(pNow, sLogStamp.Buf, sLogStamp.Len) ;
+		pNow += sLogStamp.Len ;
+	}
+	if (flag & FLAG_CB_PRE_SPC)		*pNow++ = CHR_SPACE ;
+	return pNow - pBuf ;
 }
 
 /*
- *	vLogPostPend - process all options to postpend info
- *	\brief	append all the character as per the flag in the specific sequence/priority
- *	\param	pCB - pointer to the circular buffer control structure
+ *	xLogPostPend - render all options to postpend info
+ *	\brief	render all the characters as per the flag in the specific sequence/priority
+ *	\param	pBuf - buffer of at least formLOG_POST_SIZE characters
  * 			flag	- control buffer formatting flag
- *	\return	none
+ *	\return	number of characters rendered
  */
+static	int	xLogPostPend(char * pBuf, uint32_t flag) {
+	char * pNow = pBuf ;
+	if (flag & FLAG_CB_FG_MASK)		pNow = pcANSIattrib(pNow, formMASK(FLAG_CB_FG_WHITE, FLAG_CB_FG_MASK, 29, 30), 0) ;
+	if (flag & FLAG_CB_BG_MASK)		pNow = pcANSIattrib(pNow, formMASK(FLAG_CB_BG_BLACK, FLAG_CB_BG_MASK, 25, 40), 0) ;
+	if (flag & FLAG_CB_POST_COMMA)	*pNow++ = CHR_COMMA ;
+	if (flag & FLAG_CB_POST_SPC)	*pNow++ = CHR_SPACE ;
+	if (flag & FLAG_CB_POST_TAB)	*pNow++ = CHR_TAB ;
+	if (flag & FLAG_CB_POST_CL)		*pNow++ = CHR_LF ;
+	return pNow - pBuf ;
+}
+
+void	vLogPrePend(uint32_t flag) {
+	char	Buffer[formLOG_PRE_SIZE] ;
+	printfx_lock() ;
+	int Len = xLogPrePend(Buffer, flag) ;
+	printfx_span_nolock(Buffer, Len) ;
+	printfx_unlock() ;
+}
+
 void	vLogPostPend(uint32_t flag) {
-	if (flag & FLAG_CB_FG_MASK)		vANSIattrib(formMASK(FLAG_CB_FG_WHITE, FLAG_CB_FG_MASK, 29, 30), 0) ;
-	if (flag & FLAG_CB_BG_MASK)		vANSIattrib(formMASK(FLAG_CB_BG_BLACK, FLAG_CB_BG_MASK, 25, 40), 0) ;
-    if (flag & FLAG_CB_POST_COMMA)	putcx(CHR_COMMA, configSTDIO_UART_CHAN) ;
-    if (flag & FLAG_CB_POST_SPC)	putcx(CHR_SPACE, configSTDIO_UART_CHAN) ;
-    if (flag & FLAG_CB_POST_TAB)	putcx(CHR_TAB, configSTDIO_UART_CHAN) ;
-    if (flag & FLAG_CB_POST_CL)		putcx(CHR_LF, configSTDIO_UART_CHAN) ;
+	char	Buffer[formLOG_POST_SIZE] ;
+	printfx_lock() ;
+	int Len = xLogPostPend(Buffer, flag) ;
+	printfx_span_nolock(Buffer, Len) ;
+	printfx_unlock() ;
+}
+
+/*
+ *	xLogToBuffer - stage message output, space for the suffix kept. If the message does not fit
+ *			the staged part is written & the rest streamed, caller holds printfx_lock()
+ */
+static	int	xLogToBuffer(xpc_t * psXPC, const char * pStr, size_t szLen) {
+	formlog_t * psL = psXPC->pVoid ;
+	const size_t szMax = sizeof(psL->Buf) - formLOG_POST_SIZE ;
+	if ((psL->Used + szLen) > szMax) {
+		printfx_span_nolock(psL->Buf, psL->Used) ;
+		psL->Used = 0 ;
+		if (szLen > szMax) return printfx_span_nolock(pStr, szLen) ;
+	}
+	memcpy(&psL->Buf[psL->Used], pStr, szLen) ;
+	psL->Used += szLen ;
+	return szLen ;
 }
 
+/*
+ *	vLogPrintf - render prefix, message & suffix as a single record
+ *	\brief	the record is built in a local buffer & written as one span while holding printfx_lock(),
+ *			records from concurrent tasks never interleave. A record exceeding formLOG_BUF_SIZE is
+ *			written in pieces, still under the one lock, never truncated.
+ *	\param	flag	- control buffer formatting flag
+ * 			format	- message format & arguments as for printfx()
+ *	\return	none
+ */
 void 	vLogPrintf(uint32_t flag, const char * format, ...) {
-	if (flag)						vLogPrePend(flag) ;
+	formlog_t	sLog ;
 	va_list args ;
-    va_start(args, format) ;
-    vprintfx(format, args) ;
-    va_end(args) ;
-    if (flag)						vLogPostPend(flag) ;
+	printfx_lock() ;
+	sLog.Used = flag ? xLogPrePend(sLog.Buf, flag) : 0 ;
+	va_start(args, format) ;
+	xprintfx_span(xLogToBuffer, &sLog, xpfMAXLEN_MAXVAL, format, args) ;
+	va_end(args) ;
+	if (flag) sLog.Used += xLogPostPend(sLog.Buf + sLog.Used, flag) ;
+	printfx_span_nolock(sLog.Buf, sLog.Used) ;
+	printfx_unlock() ;
 }
 
+/*
+ *	xI8ArrayPrint - print optional header & array of U8 values as "  #index=value", single lock
+ *	\param	pHeader - optional header, used as format without arguments
+ * 			pArray - pointer to values
+ * 			ArraySize - number of values
+ *	\return	number of characters output
+ */
 int32_t	xI8ArrayPrint(const char * pHeader, uint8_t * pArray, int32_t ArraySize) {
 	int32_t iRV = 0 ;
+	printfx_lock() ;
 	if (pHeader)
-		iRV += printfx(pHeader) ;
+		iRV += printfx_nolock(pHeader) ;
 	for (int32_t Idx = 0; Idx < ArraySize; ++Idx)
-		iRV += printfx("  #%d=%d", Idx, pArray[Idx]) ;
-	iRV += printfx("\n") ;
+		iRV += printfx_nolock("  #%d=%d", Idx, pArray[Idx]) ;
+	iRV += printfx_nolock("\n") ;
+	printfx_unlock() ;
 	return iRV ;
 }
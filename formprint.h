@@ -12,6 +12,15 @@
 extern "C" {
 #endif
 
+// ######################################## configuration ##########################################
+
+#ifndef		formLOG_BUF_SIZE
+	#define	formLOG_BUF_SIZE				256			// vLogPrintf() record on stack, longer written in pieces
+#endif
+#define		formLOG_STAMP_SIZE				32			// uptime or date/time rendering
+#define		formLOG_PRE_SIZE				(2 * 16 + 1 + 2 * formLOG_STAMP_SIZE + 1)
+#define		formLOG_POST_SIZE				(2 * 16 + 4)
+
 // ############################## formatting flags ############################
 
 // Foreground colour flags
@@ -3,16 +3,23 @@
  * <snf>printfx -  set of routines to replace equivalent printf functionality
  */
 
+#define	_GNU_SOURCE										// strchrnul() on glibc hosts
+
 #include	<string.h>
+#include	<stddef.h>									// ptrdiff_t
 #include	<stdarg.h>
 #include	<math.h>									// isnan()
 #include	<float.h>									// DBL_MIN/MAX
+#include	<errno.h>
+#ifndef	ESP_PLATFORM
+	#include	<sys/uio.h>								// writev()
+#endif
 
 #include	"hal_config.h"
 
 #include	"printfx.h"
 #include	"FreeRTOS_Support.h"
-#include	"x_string_general.h"						// xinstring function
+#include	"x_string_general.h"						// xstrnlen function
 #include	"x_errors_events.h"
 #include	"x_values_to_string.h"
 #include	"socketsX.h"
@@ -25,6 +32,12 @@
 #ifdef	ESP_PLATFORM
 	#include	"hal_nvic.h"
 #endif
+#if		(xpfSUPPORT_HEXDUMP == 1) && (xpfSUPPORT_HEXDUMP_MT == 1) && defined(__linux__)
+	#include	<pthread.h>
+	#include	<sys/mman.h>
+	#include	<sys/stat.h>
+	#include	<unistd.h>
+#endif
 
 #define	debugFLAG					0xE001
 
@@ -42,45 +55,149 @@ enum { form0G, form1F, form2E, form3X } ;
 
 // ######################## Character and value translation & rounding tables ######################
 
-const char vPrintStr1[] = {						// table of characters where lc/UC is applicable
-		'X',									// hex formatted 'x' or 'X' values, always there
+/* Format character classification, a single lookup per character replaces the scans of the
+ * modifier & upper case sets. Low nibble is the modifier class, upper bits are attributes */
+enum {
+	xpcNONE, xpcBANG, xpcHASH, xpcQUOTE, xpcSTAR, xpcPLUS, xpcMINUS, xpcSPACE, xpcZERO, xpcEQUAL,
+	xpcPCNT,
+} ;
+#define	xpcMOD_MASK		0x0F
+#define	xpcUCASE		0x10								// lc/UC conversion, UC sets Ucase
+#define	xpcDIGIT		0x20								// '0' -> '9'
+
+#define	xpcD(c)			[c] = xpcDIGIT
+static	const uint8_t sPrintClass[256] = {
+	['!'] = xpcBANG,	['#'] = xpcHASH,	['\''] = xpcQUOTE,	['*'] = xpcSTAR,
+	['+'] = xpcPLUS,	['-'] = xpcMINUS,	[' '] = xpcSPACE,	['%'] = xpcPCNT,
+	['='] = xpcEQUAL,
+	['0'] = xpcZERO | xpcDIGIT,
+	xpcD('1'), xpcD('2'), xpcD('3'), xpcD('4'), xpcD('5'), xpcD('6'), xpcD('7'), xpcD('8'), xpcD('9'),
+	['X'] = xpcUCASE,										// hex formatted 'x' or 'X' values, always there
 #if		(xpfSUPPORT_MAC_ADDR == 1)
-		'M',									// MAC address UC/LC
+	['M'] = xpcUCASE,										// MAC address UC/LC
 #endif
 #if		(xpfSUPPORT_IEEE754 == 1)
-		'A', 'E', 'G',							// float hex/exponential/general
+	['A'] = xpcUCASE, ['E'] = xpcUCASE, ['G'] = xpcUCASE,	// float hex/exponential/general
 #endif
 #if		(xpfSUPPORT_POINTER == 1)
-		'P',									// Pointer lc=0x or UC=0X
+	['P'] = xpcUCASE,										// Pointer lc=0x or UC=0X
 #endif
-		'\0' } ;								// terminated
+} ;
+#undef	xpcD
+
+// xpf_t flag set by each modifier class, '%' handled separately
+static	const uint32_t sPrintModFlag[xpcPCNT] = {
+	[xpcBANG]	= xpfFLAG_REL_VAL,		[xpcHASH]	= xpfFLAG_ALT_FORM,
+	[xpcQUOTE]	= xpfFLAG_GROUP,		[xpcSTAR]	= xpfFLAG_ARG_WIDTH,
+	[xpcPLUS]	= xpfFLAG_PLUS,			[xpcMINUS]	= xpfFLAG_LJUST,
+	[xpcSPACE]	= xpfFLAG_PSPC,			[xpcZERO]	= xpfFLAG_PAD0,
+	[xpcEQUAL]	= xpfFLAG_SQUEEZE,
+} ;
 
 static	const char hexchars[] = "0123456789ABCDEF" ;
 
-static	const double round_nums[xpfMAXIMUM_DECIMALS+1] = {
-	0.5, 			0.05, 			0.005, 			0.0005,			0.00005, 			0.000005, 			0.0000005, 			0.00000005,
-	0.000000005,	0.0000000005, 	0.00000000005, 	0.000000000005,	0.0000000000005, 	0.00000000000005, 	0.000000000000005, 	0.0000000000000005
-} ;
-
 // ############################## private function variables #######################################
 
 // ############################# Foundation character and string output ############################
 
+/**
+ * pcPrintNextSpec()
+ * \brief	locate the next '%' (or the terminating NUL) in a format string
+ * 			glibc supplies a vectorised strchrnul(), elsewhere scan a word at a time
+ * \param	pStr - pointer into the format string
+ * \return	pointer to the first '%' or NUL at or after pStr
+ */
+#if		defined(__GLIBC__)
+const char * pcPrintNextSpec(const char * pStr) { return strchrnul(pStr, '%') ; }
+#else
+typedef	uintptr_t __attribute__((may_alias)) xpfword_t ;
+#define	xpfWORD_ONES				((xpfword_t) -1 / 0xFF)
+#define	xpfWORD_HIGHS				(xpfWORD_ONES * 0x80)
+#define	xpfWORD_HASZERO(w)			(((w) - xpfWORD_ONES) & ~(w) & xpfWORD_HIGHS)
+
+const char * pcPrintNextSpec(const char * pStr) {
+	// step bytewise up to a word boundary, aligned loads never cross into the next page
+	while ((uintptr_t) pStr & (sizeof(xpfword_t) - 1)) {
+		if (*pStr == '%' || *pStr == 0) return pStr ;
+		++pStr ;
+	}
+	const xpfword_t * pWord = (const xpfword_t *) pStr ;
+	while (1) {
+		xpfword_t Word = *pWord ;
+		if (xpfWORD_HASZERO(Word) || xpfWORD_HASZERO(Word ^ (xpfWORD_ONES * '%'))) break ;
+		++pWord ;
+	}
+	// found in this word, locate the exact byte
+	for (pStr = (const char *) pWord; *pStr != '%' && *pStr != 0; ++pStr) ;
+	return pStr ;
+}
+#endif
+
+/**
+ * vPrintSpan
+ * \brief	output a block of characters using/via the preselected span sink
+ * 			before output clip the block ONCE against the remaining width
+ * 			adjust character count based on number of characters actually written
+ * \param	psXPC - pointer to control structure to be referenced/updated
+ * 			pStr - pointer to characters to be output, NOT NUL terminated
+ * 			Len - number of characters to output
+ * \return	none
+ */
+void	vPrintSpan(xpc_t * psXPC, const char * pStr, int Len) {
+	if (psXPC->f.maxlen) {								// limited, clip to remaining space
+		int Avail = psXPC->f.maxlen - psXPC->f.curlen ;
+		if (Len > Avail) Len = Avail ;
+	}
+	if (Len > 0) {
+		int iRV = psXPC->writer(psXPC, pStr, Len) ;
+		if (iRV > 0) psXPC->f.curlen += iRV ;			// adjust count
+	}
+}
+
+/**
+ * vPrintSpanRef
+ * \brief	output a block of characters that remains valid until the print call returns, ie format
+ * 			literals or string arguments. Sinks may reference such a block instead of copying it.
+ */
+void	vPrintSpanRef(xpc_t * psXPC, const char * pStr, int Len) {
+	psXPC->f.stable = 1 ;
+	vPrintSpan(psXPC, pStr, Len) ;
+	psXPC->f.stable = 0 ;
+}
+
 /**
  * vPrintChar
  * \brief	output a single character using/via the preselected function
- * 			before output verify against specified width
- * 			adjust character count (if required) & remaining width
  * \param	psXPC - pointer to control structure to be referenced/updated
  * 			c - char to be output
- * \return	1 or 0 based on whether char was '\000'
+ * \return	none
  */
 void	vPrintChar(xpc_t * psXPC, char cChr) {
 #if 	(xpfSUPPORT_FILTER_NUL == 1)
 	if (cChr == 0) return ;
 #endif
-	if (psXPC->f.maxlen == 0 || psXPC->f.curlen < psXPC->f.maxlen) {
-		if (psXPC->handler(psXPC, cChr) == cChr) psXPC->f.curlen++ ;	// adjust count
+	vPrintSpan(psXPC, &cChr, 1) ;
+}
+
+#define	xpfREPEAT_SIZE				16				// padding chunk, output while a string is referenced
+_Static_assert(xpfREPEAT_SIZE < xpfFD_IOV_MIN, "padding must not be referenced by an iovec") ;
+
+/**
+ * vPrintRepeat
+ * \brief	output the same character a number of times, used for padding
+ * \param	psXPC - pointer to control structure to be referenced/updated
+ * 			cChr - char to be output
+ * 			Count - number of times to output the character
+ * \return	none
+ */
+void	vPrintRepeat(xpc_t * psXPC, char cChr, int Count) {
+	char	Buffer[xpfREPEAT_SIZE] ;
+	if (Count <= 0) return ;
+	memset(Buffer, cChr, Count < (int) sizeof(Buffer) ? Count : (int) sizeof(Buffer)) ;
+	while (Count > 0) {
+		int	Len = Count < (int) sizeof(Buffer) ? Count : (int) sizeof(Buffer) ;
+		vPrintSpan(psXPC, Buffer, Len) ;
+		Count -= Len ;
 	}
 }
 
@@ -93,8 +210,8 @@ void	vPrintChar(xpc_t * psXPC, char cChr) {
  * \return	number of ACTUAL characters output.
  */
 int	xPrintChars (xpc_t * psXPC, char * pStr) {
-	int len ;
-	for (len = 0; *pStr; vPrintChar(psXPC, *pStr++), ++len) ;
+	int len = xstrlen(pStr) ;
+	vPrintSpan(psXPC, pStr, len) ;
 	return len ;
 }
 
@@ -125,9 +242,9 @@ void	vPrintString (xpc_t * psXPC, char * pStr) {
 			Lpad = Tpad ;
 		}
 	}
-	for (;Lpad--; vPrintChar(psXPC, Cpad)) ;
-	for (;Len-- && *pStr; vPrintChar(psXPC, *pStr++)) ;
-	for (;Rpad--; vPrintChar(psXPC, Cpad)) ;
+	vPrintRepeat(psXPC, Cpad, Lpad) ;
+	vPrintSpan(psXPC, pStr, xstrnlen(pStr, Len)) ;		// stop at NUL if before Len
+	vPrintRepeat(psXPC, Cpad, Rpad) ;
 }
 
 /**
@@ -144,6 +261,98 @@ char	cPrintNibbleToChar(xpc_t * psXPC, uint8_t Value) {
 	return cChr ;
 }
 
+/* Integer digit kernels, each building digits right to left ending just before pEnd and
+ * returning a pointer to the most significant character. Base 10 avoids the 64 bit divide by a
+ * runtime base by splitting off 9 digit chunks then working on 32 bit values 2 digits at a time.
+ * Base 2/8/16 use shift & mask. Thousands grouping is folded into the loops by emitting whole
+ * 3 digit groups, hence there is no per digit counter. */
+
+static	const char sPrintDigitPairs[200] = {
+	"00010203040506070809"	"10111213141516171819"	"20212223242526272829"	"30313233343536373839"
+	"40414243444546474849"	"50515253545556575859"	"60616263646566676869"	"70717273747576777879"
+	"80818283848586878889"	"90919293949596979899"
+} ;
+
+static	const char hexlower[] = "0123456789abcdef" ;
+
+static inline char * pcPrintPair(char * pEnd, uint32_t Val) {	// exactly 2 digits, Val < 100
+	pEnd -= 2 ;
+	memcpy(pEnd, &sPrintDigitPairs[Val * 2], 2) ;
+	return pEnd ;
+}
+
+static inline char * pcPrintGroup(char * pEnd, uint32_t Val) {	// exactly 3 digits, Val < 1000
+	pEnd = pcPrintPair(pEnd, Val % 100) ;
+	*--pEnd = '0' + (Val / 100) ;
+	return pEnd ;
+}
+
+/**
+ * pcPrintDigitsDec() - base 10 digits of a uint64_t value, optionally with ',' grouping
+ */
+char *	pcPrintDigitsDec(char * pEnd, uint64_t u64Val, int Group) {
+	while (u64Val > UINT32_MAX) {						// peel off 9 digit chunks, at most 2
+		uint64_t Quot = u64Val / 1000000000ULL ;
+		uint32_t Chunk = (uint32_t) (u64Val - (Quot * 1000000000ULL)) ;
+		u64Val = Quot ;
+		if (Group) {
+			for (int Idx = 0; Idx < 3; ++Idx) {
+				pEnd = pcPrintGroup(pEnd, Chunk % 1000) ;
+				*--pEnd = ',' ;
+				Chunk /= 1000 ;
+			}
+		} else {
+			for (int Idx = 0; Idx < 4; ++Idx) {
+				pEnd = pcPrintPair(pEnd, Chunk % 100) ;
+				Chunk /= 100 ;
+			}
+			*--pEnd = '0' + Chunk ;
+		}
+	}
+	uint32_t u32Val = (uint32_t) u64Val ;
+	if (Group) {
+		while (u32Val >= 1000) {
+			pEnd = pcPrintGroup(pEnd, u32Val % 1000) ;
+			*--pEnd = ',' ;
+			u32Val /= 1000 ;
+		}
+	} else {
+		while (u32Val >= 100) {
+			pEnd = pcPrintPair(pEnd, u32Val % 100) ;
+			u32Val /= 100 ;
+		}
+	}
+	if (u32Val >= 10) {									// 2 or (grouped) 3 leading digits
+		pEnd = pcPrintPair(pEnd, u32Val % 100) ;
+		if (u32Val >= 100) *--pEnd = '0' + (u32Val / 100) ;
+	} else {											// single leading digit
+		*--pEnd = '0' + u32Val ;
+	}
+	return pEnd ;
+}
+
+/**
+ * pcPrintDigitsPow2() - base 2, 8 or 16 digits of a uint64_t value, optionally with ',' grouping
+ */
+char *	pcPrintDigitsPow2(char * pEnd, uint64_t u64Val, int Base, int Ucase, int Group) {
+	IF_myASSERT(debugPARAM, Base == 2 || Base == 8 || Base == 16) ;
+	const char * pcHex = Ucase ? hexchars : hexlower ;
+	const int Shift = (Base == 16) ? 4 : (Base == 8) ? 3 : 1 ;
+	const uint32_t Mask = Base - 1 ;
+	while (1) {
+		*--pEnd = pcHex[u64Val & Mask] ;
+		if ((u64Val >>= Shift) == 0) break ;
+		if (Group) {									// complete the 3 digit group then separate
+			*--pEnd = pcHex[u64Val & Mask] ;
+			if ((u64Val >>= Shift) == 0) break ;
+			*--pEnd = pcHex[u64Val & Mask] ;
+			if ((u64Val >>= Shift) == 0) break ;
+			*--pEnd = ',' ;
+		}
+	}
+	return pEnd ;
+}
+
 /**
  * xPrintXxx() convert uint64_t value to a formatted string (right to left, L <- R)
  * \param	psXPC - pointer to control structure
@@ -194,19 +403,11 @@ int	xPrintXxx(xpc_t * psXPC, uint64_t ullVal, char * pBuffer, int BufSize) {
 		}
 #endif
 		// convert to string starting at end of buffer from Least (R) to Most (L) significant digits
-		while (ullVal) {
-			iTemp	= ullVal % psXPC->f.nbase ;			// calculate the next remainder ie digit
-			*pTemp-- = cPrintNibbleToChar(psXPC, iTemp) ;
-			++Len ;
-			ullVal	/= psXPC->f.nbase ;
-			if (ullVal && psXPC->f.group) {				// handle digit grouping, if required
-				if ((++Count % 3) == 0) {
-					*pTemp-- = ',' ;
-					++Len ;
-					Count = 0 ;
-				}
-			}
-		}
+		char * pDigits = (psXPC->f.nbase == BASE10)
+						? pcPrintDigitsDec(pTemp + 1, ullVal, psXPC->f.group)
+						: pcPrintDigitsPow2(pTemp + 1, ullVal, psXPC->f.nbase, psXPC->f.Ucase, psXPC->f.group) ;
+		Len		+= (pTemp + 1) - pDigits ;
+		pTemp	= pDigits - 1 ;
 	} else {
 		*pTemp-- = '0' ;
 		Len = 1 ;
@@ -252,221 +453,734 @@ void	vPrintX64(xpc_t * psXPC, uint64_t Value) {
 	vPrintString(psXPC, Buffer + (xpfMAX_LEN_X64 - 1 - Len)) ;
 }
 
+#if		(xpfSUPPORT_FIXEDPOINT == 1)
+static	const uint64_t sPow10U64[20] = {
+	1ULL,					10ULL,					100ULL,					1000ULL,
+	10000ULL,				100000ULL,				1000000ULL,				10000000ULL,
+	100000000ULL,			1000000000ULL,			10000000000ULL,			100000000000ULL,
+	1000000000000ULL,		10000000000000ULL,		100000000000000ULL,		1000000000000000ULL,
+	10000000000000000ULL,	100000000000000000ULL,	1000000000000000000ULL,	10000000000000000000ULL
+} ;
+
 /**
- * vPrintF64()
- * \brief	convert double value based on flags supplied and output via control structure
- * \param[in]	psXPC - pointer to control structure
- * \param[in]	dbl - double value to be converted
- * \return		none
- *
- * References:
- * 	http://git.musl-libc.org/cgit/musl/blob/src/stdio/vfprintf.c?h=v1.1.6
+ * vPrintFixed()
+ * \brief	convert a scaled (fixed point) integer to decimal using integer arithmetic only
+ * 			Precision, trailing zero removal, width, '+', '0' & "'" handled as for %f, '#' ignored
+ * 			Precision limited to xpfMAX_FIXED_DECIMALS, the fraction digits a uint64_t can hold
+ * \param	psXPC - pointer to control structure
+ * 			Value - signed scaled value
+ * 			Scale - number of binary (Q format, max 60) or decimal (max 19) fraction digits
+ * 			Binary - 1 = Value x 2^-Scale, 0 = Value x 10^-Scale
+ * \return	none
  */
-void	vPrintF64(xpc_t * psXPC, double F64) {
-	if (isnan(F64)) {
-		vPrintString(psXPC, psXPC->f.Ucase ? "NAN" : "nan") ;
-		return ;
-	} else if (isinf(F64)) {
-		vPrintString(psXPC, psXPC->f.Ucase ? "INF" : "inf") ;
-		return ;
-	}
-	psXPC->f.negvalue	= F64 < 0.0 ? 1 : 0 ;			// set negvalue if < 0.0
-	F64	*= psXPC->f.negvalue ? -1.0 : 1.0 ;				// convert to positive number
-	xpf_t xpf ;
-	xpf.limits	= psXPC->f.limits ;						// save original flags
-	xpf.flags	= psXPC->f.flags ;
-	x64_t X64 	= { 0 } ;
-
-	int	Exp = 0 ;										// if exponential format requested, calculate the exponent
-	if (F64 != 0.0) {									// if not 0 and...
-		if (psXPC->f.form != form1F) {					// any of "eEgG" specified ?
-			X64.f64	= F64 ;
-			while (X64.f64 > 10.0) {					// if number is greater that 10.0
-				X64.f64 /= 10.0 ;						// re-adjust and
-				Exp += 1 ;								// update exponent
-			}
-			while (X64.f64 < 1.0) {						// similarly, if number smaller than 1.0
-				X64.f64 *= 10.0 ;						// re-adjust upwards and
-				Exp	-= 1 ;								// update exponent
-			}
+void	vPrintFixed(xpc_t * psXPC, int64_t Value, int Scale, int Binary) {
+	psXPC->f.negvalue	= Value < 0 ? 1 : 0 ;
+	psXPC->f.alt_form	= 0 ;							// '#' would SI scale in xPrintXxx()
+	uint64_t Mag = psXPC->f.negvalue ? -(uint64_t) Value : (uint64_t) Value ;
+	int	Precis = psXPC->f.arg_prec ? psXPC->f.precis : xpfDEFAULT_DECIMALS ;
+	Precis = Precis > xpfMAX_FIXED_DECIMALS ? xpfMAX_FIXED_DECIMALS : Precis ;
+	uint64_t Whole, Frac = 0, Rem ;
+	uint8_t	Up = 0 ;
+	// split, then scale fraction to Precis digits rounding half even
+	if (Binary) {
+		IF_myASSERT(debugPARAM, INRANGE(0, Scale, 60, int)) ;
+		Scale	= Scale > 60 ? 60 : Scale < 0 ? 0 : Scale ;
+		uint64_t Mask = (1ULL << Scale) - 1 ;
+		Whole	= Mag >> Scale ;
+		Rem		= Mag & Mask ;
+		for (int Idx = 0; Idx < Precis; ++Idx) {		// Rem < 2^60, x10 cannot overflow
+			Rem		*= 10 ;
+			Frac	= (Frac * 10) + (Rem >> Scale) ;
+			Rem		&= Mask ;
+		}
+		if (Scale) {
+			uint64_t Half = 1ULL << (Scale - 1) ;
+			Up = (Rem > Half || (Rem == Half && (Frac & 1))) ? 1 : 0 ;
 		}
-	}
-	uint8_t	AdjForm ;
-	if (psXPC->f.form == form0G) {						// 'gG' req, check exponent & select mode.
-		AdjForm = Exp < -4 || Exp >= psXPC->f.precis ? form2E : form1F ;
 	} else {
-		AdjForm = psXPC->f.form ;
+		IF_myASSERT(debugPARAM, INRANGE(0, Scale, 19, int)) ;
+		Scale	= Scale > 19 ? 19 : Scale < 0 ? 0 : Scale ;
+		Whole	= Mag / sPow10U64[Scale] ;
+		Rem		= Mag % sPow10U64[Scale] ;
+		if (Precis >= Scale) {							// exact, extend with zeros
+			Frac	= Rem * sPow10U64[Precis - Scale] ;
+		} else {
+			uint64_t Div = sPow10U64[Scale - Precis] ;
+			Frac	= Rem / Div ;
+			Rem		%= Div ;
+			Up = (Rem > (Div - Rem) || (Rem == (Div - Rem) && (Frac & 1))) ? 1 : 0 ;
+		}
 	}
-	if (AdjForm == form2E) F64 = X64.f64 ;				// change to exponent adjusted value
-	if (F64 < (DBL_MAX - round_nums[psXPC->f.precis])) {// if addition of rounding value will NOT cause overflow.
-		F64 += round_nums[psXPC->f.precis] ;			// round by adding .5LSB to the value
+	if (Up && (++Frac == sPow10U64[Precis])) {			// carry into whole part
+		Frac = 0 ;
+		++Whole ;
 	}
-	char	Buffer[xpfMAX_LEN_F64] ;
-	Buffer[xpfMAX_LEN_F64 - 1] = 0 ;					// building R to L, ensure buffer NULL-term
-
+	char	Buffer[xpfMAX_LEN_FIXED] ;
+	Buffer[xpfMAX_LEN_FIXED - 1] = 0 ;					// building R to L, ensure buffer NULL-term
+	xpf_t xpf ;
+	xpf.limits	= psXPC->f.limits ;						// save original flags
+	xpf.flags	= psXPC->f.flags ;
 	int Len = 0 ;
-	if (AdjForm == form2E) {							// If required, handle the exponent
-		psXPC->f.minwid		= 2 ;
-		psXPC->f.pad0		= 1 ;						// MUST left pad with '0'
-		psXPC->f.signval	= 1 ;
-		psXPC->f.ljust		= 0 ;
-		psXPC->f.negvalue	= (Exp < 0) ? 1 : 0 ;
-		Exp *= psXPC->f.negvalue ? -1LL : 1LL ;
-		Len += xPrintXxx(psXPC, Exp, Buffer, xpfMAX_LEN_F64 - 1) ;
-		Buffer[xpfMAX_LEN_F64-2-Len] = psXPC->f.Ucase ? 'E' : 'e' ;
-		++Len ;
-	}
-
-	X64.f64	= F64 - (uint64_t) F64 ;					// isolate fraction as double
-	X64.f64	= X64.f64 * (double) u64pow(10, psXPC->f.precis) ;	// fraction to integer
-	X64.u64	= (uint64_t) X64.f64 ;						// extract integer portion
-
-	if (psXPC->f.arg_prec) {							// explicit minwid specified ?
-		psXPC->f.minwid	= psXPC->f.precis ; 			// yes, stick to it.
-	} else if (X64.u64 == 0) {							// process 0 value
-		psXPC->f.minwid	= psXPC->f.radix ? 1 : 0;
-	} else {											// process non 0 value
-		if (psXPC->f.alt_form && psXPC->f.form == form0G) {
-			psXPC->f.minwid	= psXPC->f.precis ;			// keep trailing 0's
-		} else {
-			uint32_t u = u64Trailing0(X64.u64) ;
-			X64.u64 /= u64pow(10, u) ;
-			psXPC->f.minwid	= psXPC->f.precis - u ;		// remove trailing 0's
+	if (psXPC->f.arg_prec) {							// explicit precision, stick to it
+		psXPC->f.minwid	= Precis ;
+	} else if (Frac == 0) {
+		psXPC->f.minwid	= psXPC->f.radix ? 1 : 0 ;
+	} else {											// remove trailing 0's
+		while ((Frac % 10) == 0) {
+			Frac /= 10 ;
+			--Precis ;
 		}
+		psXPC->f.minwid	= Precis ;
 	}
 	if (psXPC->f.minwid > 0) {
 		psXPC->f.pad0		= 1 ;						// MUST left pad with '0'
+		psXPC->f.ljust		= 0 ;						// not left justified
 		psXPC->f.group		= 0 ;						// cannot group in fractional
-		psXPC->f.signval	= 0 ;						// always unsigned value
+		psXPC->f.alt_form	= 0 ;						// or scale
 		psXPC->f.negvalue	= 0 ;						// and never negative
 		psXPC->f.plus		= 0 ;						// no leading +/- before fractional part
-		Len += xPrintXxx(psXPC, X64.u64, Buffer, xpfMAX_LEN_F64-1-Len) ;
+		Len += xPrintXxx(psXPC, Frac, Buffer, xpfMAX_LEN_FIXED - 1) ;
 	}
-	// process the radix = '.'
-	if (psXPC->f.minwid || psXPC->f.radix) {
-		Buffer[xpfMAX_LEN_F64 - 2 - Len] = '.' ;
+	if (psXPC->f.minwid || psXPC->f.radix) {			// process the radix = '.'
+		Buffer[xpfMAX_LEN_FIXED - 2 - Len] = '.' ;
 		++Len ;
 	}
-
-	X64.u64	= F64 ;										// extract and convert the whole number portions
 	psXPC->f.limits	= xpf.limits ;						// restore original limits & flags
 	psXPC->f.flags	= xpf.flags ;
-
-	// adjust minwid to do padding (if required) based on string length after adding whole number
 	psXPC->f.minwid	= psXPC->f.minwid > Len ? psXPC->f.minwid - Len : 0 ;
-	Len += xPrintXxx(psXPC, X64.u64, Buffer, xpfMAX_LEN_F64 - 1 - Len) ;
-
+	Len += xPrintXxx(psXPC, Whole, Buffer, xpfMAX_LEN_FIXED - 1 - Len) ;
 	psXPC->f.arg_prec	= 1 ;
 	psXPC->f.precis		= Len ;
-	psXPC->f.arg_width	= xpf.arg_width ;
 	psXPC->f.minwid		= xpf.minwid ;
-	vPrintString(psXPC, Buffer + (xpfMAX_LEN_F64 - 1 - Len)) ;
+	vPrintString(psXPC, Buffer + (xpfMAX_LEN_FIXED - 1 - Len)) ;
+}
+#endif
+
+#if		(xpfSUPPORT_IEEE754 == 1)
+/* ################################ IEEE754 double to decimal digits ##############################
+ * Digits are produced by a generator presenting the value as 0.ddddd x 10^DP with the first digit
+ * non-zero (except for 0.0) and zeros following the last significant digit. Two sources exist:
+ * Exact - integer part scaled to base 1e9 words, fraction kept as a binary fraction that yields 9
+ *		digits per multiply by 1e9. Only integer arithmetic, bounded by the 2^1024 / 2^-1074 range.
+ * Shortest - Grisu2 digits, the shortest (in all but rare cases) string that reads back the same.
+ * The generator can be rewound, the formatter scans once to establish the round half even result
+ * & output length, then rescans to stream the digits. No digit buffer proportional to the
+ * precision is required.
+ */
+
+#define	xpfF64_INT_WORDS				2			// integer part words while fraction present
+#define	xpfF64_WORDS					(xpfF64_INT_WORDS + 34)	// 2^1024 = 35 base 1e9 words, 2^-1074 = 34 binary
+#define	xpfF64_CACHE					40			// leading digits retained, avoid rescan
+
+typedef	struct xpfd_t {
+	const char *	pcSrc ;								// shortest, digit string else NULL
+	uint64_t		Mant ;								// exact, binary mantissa
+	int32_t			Shift ;								// exact, number of fraction bits
+	int32_t			DP ;								// decimal point position
+	int16_t			nSrc, iSrc ;						// shortest, digits available & next
+	int16_t			nInt, iInt ;						// exact, base 1e9 integer words (LS first) & next
+	int16_t			nFrac, iTop ;						// exact, binary fraction words & first non zero
+	int8_t			iDig, nDig ;						// exact, position in current block
+	uint8_t			Digs[9] ;							// exact, current block as digit values
+	int32_t			nRead ;								// digits read since rewind
+	int32_t			nCache ;							// leading digits cached
+	uint8_t			Cache[xpfF64_CACHE] ;
+	uint32_t		Word[xpfF64_WORDS] ;
+} xpfd_t ;
+
+typedef	struct xpfr_t {									// result of rounding to Count digits
+	int32_t			Count ;								// number of digits
+	int32_t			DP ;								// decimal point position, after carry
+	int32_t			LastN9 ;							// last digit not a '9', -1 if all '9'
+	int32_t			LastNZ ;							// last non '0' digit, -1 if all '0'
+	uint8_t			Up ;								// 1 = round up
+} xpfr_t ;
+
+static	void	vPrintDigitsLoad(xpfd_t * psD, uint32_t Block, int Width) {
+	psD->iDig	= 0 ;
+	psD->nDig	= Width ;
+	while (Width--) {
+		psD->Digs[Width] = Block % 10 ;
+		Block /= 10 ;
+	}
+}
+
+static	uint32_t u32PrintFracBlock(xpfd_t * psD) {		// next 9 fraction digits as a value
+	uint32_t * pFrac = &psD->Word[xpfF64_INT_WORDS] ;
+	uint32_t Carry = 0 ;
+	for (int Idx = psD->nFrac - 1; Idx >= psD->iTop; --Idx) {	// leading zero words skipped
+		uint64_t Tmp = ((uint64_t) pFrac[Idx] * 1000000000UL) + Carry ;
+		pFrac[Idx]	= (uint32_t) Tmp ;
+		Carry		= Tmp >> 32 ;
+	}
+	while (psD->nFrac && pFrac[psD->nFrac - 1] == 0) --psD->nFrac ;
+	if (psD->iTop == 0) return Carry ;					// carry out of the MS word, next 9 digits
+	if (Carry) pFrac[--psD->iTop] = Carry ;
+	return 0 ;
+}
+
+static	int	xPrintDigitNext(xpfd_t * psD) {
+	if (psD->pcSrc) return (psD->iSrc < psD->nSrc) ? psD->pcSrc[psD->iSrc++] - '0' : 0 ;
+	if (psD->iDig == psD->nDig) {						// current block exhausted, load next
+		if (psD->iInt) {
+			--psD->iInt ;
+			vPrintDigitsLoad(psD, psD->Word[psD->iInt], 9) ;
+		} else if (psD->nFrac) {
+			vPrintDigitsLoad(psD, u32PrintFracBlock(psD), 9) ;
+		} else {
+			return 0 ;
+		}
+	}
+	return psD->Digs[psD->iDig++] ;
+}
+
+static	int	xPrintDigitsRest(xpfd_t * psD) {			// any non zero digit remaining ?
+	if (psD->pcSrc) {
+		for (int Idx = psD->iSrc; Idx < psD->nSrc; ++Idx) if (psD->pcSrc[Idx] != '0') return 1 ;
+		return 0 ;
+	}
+	for (int Idx = psD->iDig; Idx < psD->nDig; ++Idx) if (psD->Digs[Idx]) return 1 ;
+	for (int Idx = 0; Idx < psD->iInt; ++Idx) if (psD->Word[Idx]) return 1 ;
+	return psD->nFrac != 0 ;
+}
+
+static	void	vPrintDigitsRewind(xpfd_t * psD) {
+	psD->nRead = 0 ;
+	if (psD->pcSrc) {
+		psD->iSrc = 0 ;
+		return ;
+	}
+	psD->iDig = psD->nDig = 0 ;
+	psD->iInt = psD->nFrac = psD->iTop = 0 ;
+	if (psD->Shift) {									// rebuild binary fraction, LS bit aligned
+		uint32_t * pFrac = &psD->Word[xpfF64_INT_WORDS] ;
+		int nFrac	= (psD->Shift + 31) / 32 ;
+		int Pad		= (nFrac * 32) - psD->Shift ;
+		uint64_t Bits = (psD->Shift < 64) ? psD->Mant & ((1ULL << psD->Shift) - 1) : psD->Mant ;
+		memset(pFrac, 0, nFrac * sizeof(uint32_t)) ;
+		pFrac[nFrac - 1] = (uint32_t) (Bits << Pad) ;
+		if (nFrac > 1) pFrac[nFrac - 2] = (uint32_t) (Bits >> (32 - Pad)) ;
+		if (nFrac > 2 && Pad) pFrac[nFrac - 3] = (uint32_t) (Bits >> (64 - Pad)) ;
+		psD->nFrac = nFrac ;
+		while (psD->nFrac && pFrac[psD->nFrac - 1] == 0) --psD->nFrac ;
+		psD->iTop = 0 ;
+		while (psD->iTop < psD->nFrac && pFrac[psD->iTop] == 0) ++psD->iTop ;
+	}
+	if (psD->nInt) {									// first integer word, leading zeros suppressed
+		uint32_t Top = psD->Word[psD->nInt - 1] ;
+		int Width = 1 ;
+		for (uint32_t Lim = 10; Width < 9 && Top >= Lim; Lim *= 10) ++Width ;
+		psD->iInt = psD->nInt - 1 ;
+		vPrintDigitsLoad(psD, Top, Width) ;
+		psD->DP = Width + (9 * psD->iInt) ;
+	} else {											// pure fraction, skip leading zeros
+		int32_t Zeros = 0 ;
+		uint32_t Block ;
+		while ((Block = u32PrintFracBlock(psD)) == 0) Zeros += 9 ;
+		vPrintDigitsLoad(psD, Block, 9) ;
+		while (psD->Digs[psD->iDig] == 0) {
+			++psD->iDig ;
+			++Zeros ;
+		}
+		psD->DP = -Zeros ;
+	}
 }
 
 /**
- * vPrintHexU8()
- * \brief		write char value as 2 hex chars to the buffer, always NULL terminated
- * \param[in]	psXPC - pointer to control structure
- * \param[in]	Value - unsigned byte to convert
- * return		none
+ * xPrintDigitAt() - digit at index Idx, from cache else generator (rewinding if already passed)
  */
-void	vPrintHexU8(xpc_t * psXPC, uint8_t Value) {
-	vPrintChar(psXPC, cPrintNibbleToChar(psXPC, Value >> 4)) ;
-	vPrintChar(psXPC, cPrintNibbleToChar(psXPC, Value & 0x0F)) ;
+static	int	xPrintDigitAt(xpfd_t * psD, int32_t Idx) {
+	if (Idx < psD->nCache) return psD->Cache[Idx] ;
+	if (Idx < psD->nRead) vPrintDigitsRewind(psD) ;
+	int Dig ;
+	do {
+		Dig = xPrintDigitNext(psD) ;
+		if (psD->nRead == psD->nCache && psD->nCache < xpfF64_CACHE) psD->Cache[psD->nCache++] = Dig ;
+		++psD->nRead ;
+	} while (psD->nRead <= Idx) ;
+	return Dig ;
+}
+
+static	int	xPrintDigitsRestAt(xpfd_t * psD, int32_t Idx) {	// any non zero digit after Idx ?
+	if (psD->nRead > psD->nCache && psD->nRead != (Idx + 1)) {
+		vPrintDigitsRewind(psD) ;						// read beyond cache, reposition
+		xPrintDigitAt(psD, Idx) ;
+	}
+	for (int32_t Pos = Idx + 1; Pos < psD->nRead; ++Pos) if (psD->Cache[Pos]) return 1 ;
+	return xPrintDigitsRest(psD) ;
 }
 
 /**
- * vPrintHexU16()
- * \brief		write uint16_t value as 4 hex chars to the buffer, always NULL terminated
- * \param[in]	psXPC - pointer to control structure
- * \param[in]	Value - unsigned byte to convert
- * return		none
+ * vPrintDigitsExact() - setup exact digit generator for a finite, non zero, positive double
  */
-void	vPrintHexU16(xpc_t * psXPC, uint16_t Value) {
-	vPrintHexU8(psXPC, (Value >> 8) & 0x000000FF) ;
-	vPrintHexU8(psXPC, Value & 0x000000FF) ;
+static	void	vPrintDigitsExact(xpfd_t * psD, double F64) {
+	x64_t	X64 = { .f64 = F64 } ;
+	int32_t	Exp2 = (X64.u64 >> 52) & 0x7FF ;
+	uint64_t Mant = X64.u64 & 0x000FFFFFFFFFFFFFULL ;
+	if (Exp2) {
+		Mant	|= 1ULL << 52 ;
+		Exp2	-= 1075 ;
+	} else {
+		Exp2	= -1074 ;								// sub-normal
+	}
+	psD->pcSrc	= NULL ;
+	psD->Mant	= Mant ;
+	psD->Shift	= Exp2 < 0 ? -Exp2 : 0 ;
+	uint64_t IntPart = (Exp2 >= 0) ? Mant : (Exp2 > -64) ? Mant >> -Exp2 : 0 ;
+	int nInt = 0 ;
+	while (IntPart) {									// at most 2 words of 53 bits
+		psD->Word[nInt++] = IntPart % 1000000000UL ;
+		IntPart /= 1000000000UL ;
+	}
+	for (int Sh; Exp2 > 0; Exp2 -= Sh) {				// scale up by 2^Exp2, 29 bits per pass
+		Sh = (Exp2 > 29) ? 29 : Exp2 ;
+		uint32_t Carry = 0 ;
+		for (int Idx = 0; Idx < nInt; ++Idx) {
+			uint64_t Tmp = ((uint64_t) psD->Word[Idx] << Sh) + Carry ;
+			psD->Word[Idx]	= Tmp % 1000000000UL ;
+			Carry			= Tmp / 1000000000UL ;
+		}
+		if (Carry) psD->Word[nInt++] = Carry ;
+	}
+	psD->nInt	= nInt ;
+}
+
+/* Grisu2, after Florian Loitsch "Printing Floating-Point Numbers Quickly and Accurately with
+ * Integers" (PLDI 2010). Cached powers are 10^(8i - 348) as 64 bit significand & binary exponent */
+
+static	const uint64_t sGrisuPowF[87] = {
+	0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL, 0xcf42894a5dce35eaULL,
+	0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL, 0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL,
+	0xbe5691ef416bd60cULL, 0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+	0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL, 0xc21094364dfb5637ULL,
+	0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL, 0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL,
+	0xb23867fb2a35b28eULL, 0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+	0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL, 0xb5b5ada8aaff80b8ULL,
+	0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL, 0x964e858c91ba2655ULL, 0xdff9772470297ebdULL,
+	0xa6dfbd9fb8e5b88fULL, 0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+	0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL, 0xaa242499697392d3ULL,
+	0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL, 0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL,
+	0x9c40000000000000ULL, 0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+	0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL, 0x9f4f2726179a2245ULL,
+	0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL, 0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL,
+	0x924d692ca61be758ULL, 0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+	0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL, 0x952ab45cfa97a0b3ULL,
+	0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL, 0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL,
+	0x88fcf317f22241e2ULL, 0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+	0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL, 0x8bab8eefb6409c1aULL,
+	0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL, 0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL,
+	0x80444b5e7aa7cf85ULL, 0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+	0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL,
+} ;
+
+static	const int16_t sGrisuPowE[87] = {
+	-1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954, -927,
+	-901, -874, -847, -821, -794, -768, -741, -715, -688, -661, -635, -608,
+	-582, -555, -529, -502, -475, -449, -422, -396, -369, -343, -316, -289,
+	-263, -236, -210, -183, -157, -130, -103, -77, -50, -24, 3, 30,
+	56, 83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+	375, 402, 428, 455, 481, 508, 534, 561, 588, 614, 641, 667,
+	694, 720, 747, 774, 800, 827, 853, 880, 907, 933, 960, 986,
+	1013, 1039, 1066,
+} ;
+
+static	const uint32_t sPow10U32[10] = {
+	1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+} ;
+
+typedef	struct { uint64_t f ; int32_t e ; } xpfdiy_t ;
+
+static	xpfdiy_t sGrisuMul(xpfdiy_t A, xpfdiy_t B) {	// upper 64 bits of the product, rounded
+	uint64_t a = A.f >> 32, b = A.f & 0xFFFFFFFF, c = B.f >> 32, d = B.f & 0xFFFFFFFF ;
+	uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d ;
+	uint64_t Tmp = (bd >> 32) + (ad & 0xFFFFFFFF) + (bc & 0xFFFFFFFF) + (1UL << 31) ;
+	return (xpfdiy_t) { ac + (ad >> 32) + (bc >> 32) + (Tmp >> 32), A.e + B.e + 64 } ;
+}
+
+static	void	vGrisuRound(char * pBuf, int Len, uint64_t Delta, uint64_t Rest, uint64_t TenK, uint64_t WpW) {
+	while (Rest < WpW && (Delta - Rest) >= TenK && ((Rest + TenK) < WpW || (WpW - Rest) > (Rest + TenK - WpW))) {
+		pBuf[Len - 1]--;
+		Rest += TenK ;
+	}
 }
 
 /**
- * vPrintHexU32()
- * \brief		write uint32_t value as 8 hex chars to the buffer, always NULL terminated
- * \param[in]	psXPC - pointer to control structure
- * \param[in]	Value - unsigned byte to convert
- * return		none
+ * xPrintGrisu2() - shortest digits for a finite, non zero, positive double
+ * \param	pBuf - buffer for at least 18 digits
+ * 			pK - decimal exponent, value = digits x 10^K
+ * \return	number of digits
+ */
+static	int	xPrintGrisu2(double F64, char * pBuf, int32_t * pK) {
+	x64_t	X64 = { .f64 = F64 } ;
+	int32_t	Exp2 = (X64.u64 >> 52) & 0x7FF ;
+	xpfdiy_t V = { X64.u64 & 0x000FFFFFFFFFFFFFULL, -1074 } ;
+	if (Exp2) {
+		V.f	|= 1ULL << 52 ;
+		V.e	= Exp2 - 1075 ;
+	}
+	// normalised boundaries m+ & m-, with m- scaled to the exponent of m+
+	xpfdiy_t Wp = { (V.f << 1) + 1, V.e - 1 } ;
+	int Lz = __builtin_clzll(Wp.f) ;
+	Wp.f <<= Lz ;
+	Wp.e -= Lz ;
+	xpfdiy_t Wm = (V.f == (1ULL << 52)) ? (xpfdiy_t) { (V.f << 2) - 1, V.e - 2 } : (xpfdiy_t) { (V.f << 1) - 1, V.e - 1 } ;
+	Wm.f <<= Wm.e - Wp.e ;
+	Wm.e = Wp.e ;
+	Lz = __builtin_clzll(V.f) ;
+	V.f <<= Lz ;
+	V.e -= Lz ;
+	// cached power c = 10^-K bringing the exponent of m+ into [-60, -32], k = ceil((-61 - e) * log10(2))
+	int32_t Dk = ((-61 - Wp.e) * 315653 + (1 << 20) - 1) >> 20 ;
+	int Idx = ((Dk + 347) >> 3) + 1 ;
+	*pK = 348 - (Idx << 3) ;
+	xpfdiy_t C = { sGrisuPowF[Idx], sGrisuPowE[Idx] } ;
+	xpfdiy_t W = sGrisuMul(V, C) ;
+	Wp = sGrisuMul(Wp, C) ;
+	Wm = sGrisuMul(Wm, C) ;
+	++Wm.f ;
+	--Wp.f ;
+	// digit generation
+	uint64_t Delta = Wp.f - Wm.f ;
+	const int One = -Wp.e ;
+	const uint64_t Mask = (1ULL << One) - 1 ;
+	const uint64_t WpW = Wp.f - W.f ;
+	uint32_t P1 = Wp.f >> One ;
+	uint64_t P2 = Wp.f & Mask ;
+	int Kappa = 1 ;
+	while (Kappa < 10 && P1 >= sPow10U32[Kappa]) ++Kappa ;
+	int Len = 0 ;
+	while (Kappa > 0) {
+		uint32_t Dig = P1 / sPow10U32[Kappa - 1] ;
+		P1 %= sPow10U32[Kappa - 1] ;
+		if (Dig || Len) pBuf[Len++] = '0' + Dig ;
+		--Kappa ;
+		uint64_t Tmp = ((uint64_t) P1 << One) + P2 ;
+		if (Tmp <= Delta) {
+			*pK += Kappa ;
+			vGrisuRound(pBuf, Len, Delta, Tmp, (uint64_t) sPow10U32[Kappa] << One, WpW) ;
+			return Len ;
+		}
+	}
+	while (1) {
+		P2		*= 10 ;
+		Delta	*= 10 ;
+		int Dig = P2 >> One ;
+		if (Dig || Len) pBuf[Len++] = '0' + Dig ;
+		P2 &= Mask ;
+		--Kappa ;
+		if (P2 < Delta) {
+			*pK += Kappa ;
+			vGrisuRound(pBuf, Len, Delta, P2, 1ULL << One, (-Kappa < 10) ? WpW * sPow10U32[-Kappa] : 0) ;
+			return Len ;
+		}
+	}
+}
+
+/**
+ * vPrintDigitsRound() - scan Count digits and decide the round half even result
  */
-void	vPrintHexU32(xpc_t * psXPC, uint32_t Value) {
-	vPrintHexU16(psXPC, (Value >> 16) & 0x0000FFFF) ;
-	vPrintHexU16(psXPC, Value & 0x0000FFFF) ;
+static	void	vPrintDigitsRound(xpfd_t * psD, int32_t Count, xpfr_t * psR) {
+	psR->Count	= Count ;
+	psR->DP		= psD->DP ;
+	psR->LastN9	= -1 ;
+	psR->LastNZ	= -1 ;
+	int Dig = 0 ;
+	for (int32_t Idx = 0; Idx < Count; ++Idx) {
+		Dig = xPrintDigitAt(psD, Idx) ;
+		if (Dig != 9) psR->LastN9 = Idx ;
+		if (Dig != 0) psR->LastNZ = Idx ;
+	}
+	int Next = (Count >= 0) ? xPrintDigitAt(psD, Count) : 0 ;
+	psR->Up = (Next > 5 || (Next == 5 && (xPrintDigitsRestAt(psD, Count) || (Dig & 1)))) ? 1 : 0 ;
+	if (psR->Up) {
+		psR->LastNZ = psR->LastN9 ;
+		if (psR->LastN9 < 0) {							// all '9' => 1 followed by zeros
+			psR->LastNZ = 0 ;
+			psR->DP += 1 ;
+			psR->Count += 1 ;
+		}
+	}
+}
+
+static	int	xPrintDigitRounded(xpfd_t * psD, const xpfr_t * psR, int32_t Idx) {
+	if (psR->Up == 0) return xPrintDigitAt(psD, Idx) ;
+	if (psR->LastN9 < 0) return Idx == 0 ? 1 : 0 ;		// carry case, no source digits used
+	int Dig = xPrintDigitAt(psD, Idx) ;
+	return (Idx < psR->LastN9) ? Dig : (Idx == psR->LastN9) ? Dig + 1 : 0 ;
 }
 
 /**
- * vPrintHexU64()
- * \brief		write uint64_t value as 16 hex chars to the buffer, always NULL terminated
+ * vPrintF64()
+ * \brief	convert double value based on flags supplied and output via control structure
+ * 			Output is exact & correctly rounded (half even) at any precision. With the '!'
+ * 			modifier the precision is ignored and the shortest round trip digits are output.
  * \param[in]	psXPC - pointer to control structure
- * \param[in]	Value - unsigned byte to convert
- * return		none
+ * \param[in]	dbl - double value to be converted
+ * \return		none
  */
-void	vPrintHexU64(xpc_t * psXPC, uint64_t Value) {
-	vPrintHexU32(psXPC, (Value >> 32) & 0xFFFFFFFFULL) ;
-	vPrintHexU32(psXPC, Value & 0xFFFFFFFFULL) ;
+void	vPrintF64(xpc_t * psXPC, double F64) {
+	if (isnan(F64)) {
+		vPrintString(psXPC, psXPC->f.Ucase ? "NAN" : "nan") ;
+		return ;
+	} else if (isinf(F64)) {
+		vPrintString(psXPC, psXPC->f.Ucase ? "INF" : "inf") ;
+		return ;
+	}
+	psXPC->f.negvalue	= F64 < 0.0 ? 1 : 0 ;			// set negvalue if < 0.0
+	F64	*= psXPC->f.negvalue ? -1.0 : 1.0 ;				// convert to positive number
+
+	xpfd_t	sD ;
+	xpfr_t	sR ;
+	char	Shortest[20] ;
+	int32_t	Precis = psXPC->f.precis ;
+	uint8_t	Exact = psXPC->f.rel_val ? 0 : 1 ;
+	if (F64 == 0.0) {
+		sD.pcSrc	= "0" ;
+		sD.nSrc		= 1 ;
+		sD.DP		= 1 ;
+	} else if (Exact) {
+		vPrintDigitsExact(&sD, F64) ;
+	} else {
+		int32_t K ;
+		sD.pcSrc	= Shortest ;
+		sD.nSrc		= xPrintGrisu2(F64, Shortest, &K) ;
+		sD.DP		= sD.nSrc + K ;
+	}
+	vPrintDigitsRewind(&sD) ;							// establish DP
+	sD.nCache	= 0 ;
+
+	// select form, 'gG' based on exponent after rounding to precision
+	uint8_t	AdjForm = psXPC->f.form ;
+	if (Exact == 0) Precis = (AdjForm == form1F) ? (sD.nSrc > sD.DP ? sD.nSrc - sD.DP : 0) : sD.nSrc - 1 ;
+	if (AdjForm != form1F) {
+		vPrintDigitsRound(&sD, Precis + 1, &sR) ;
+		if (AdjForm == form0G) {
+			int32_t Exp = sR.DP - 1 ;
+			AdjForm = (Exp < -4 || Exp >= psXPC->f.precis) ? form2E : form1F ;
+			if (AdjForm == form1F && Exact == 0) Precis = sD.nSrc > sD.DP ? sD.nSrc - sD.DP : 0 ;
+		}
+	}
+	if (AdjForm == form1F) vPrintDigitsRound(&sD, sD.DP + Precis, &sR) ;
+
+	// integer part digits & position of the first fraction digit within the rounded digits
+	int32_t	IntDigits, FracPos, Exp = 0 ;
+	if (AdjForm == form2E) {
+		IntDigits	= 1 ;
+		FracPos		= 1 ;
+		Exp			= (F64 == 0.0) ? 0 : sR.DP - 1 ;
+	} else {
+		IntDigits	= (sR.DP > 0) ? sR.DP : 1 ;
+		FracPos		= sR.DP ;
+	}
+	// number of fraction digits, strip trailing zeros unless explicit precision (or '#' with 'gG')
+	int32_t	FracDigits = Precis ;
+	if (psXPC->f.arg_prec == 0 || Exact == 0) {
+		if (sR.LastNZ < FracPos || sR.LastNZ < 0) {
+			FracDigits	= psXPC->f.radix ? 1 : 0 ;
+		} else if (Exact == 0 || psXPC->f.alt_form == 0 || psXPC->f.form != form0G) {
+			FracDigits	= sR.LastNZ - FracPos + 1 ;
+		}
+	}
+	// exponent, built R to L exactly as for integers
+	char	ExpBuf[8] ;
+	int		ExpLen = 0 ;
+	if (AdjForm == form2E) {
+		xpc_t	sExp ;
+		sExp.f.flags	= 0 ;
+		sExp.f.limits	= 0 ;
+		sExp.f.minwid	= 2 ;
+		sExp.f.pad0		= 1 ;						// MUST left pad with '0'
+		sExp.f.nbase	= BASE10 ;
+		sExp.f.plus		= psXPC->f.plus ;
+		sExp.f.negvalue	= (Exp < 0) ? 1 : 0 ;
+		ExpLen = xPrintXxx(&sExp, (Exp < 0) ? -Exp : Exp, ExpBuf, sizeof(ExpBuf)) ;
+		ExpBuf[sizeof(ExpBuf) - 1 - ExpLen] = psXPC->f.Ucase ? 'E' : 'e' ;
+		++ExpLen ;
+	}
+	uint8_t	Sign = (psXPC->f.negvalue || psXPC->f.plus) ? 1 : 0 ;
+	uint8_t	Radix = (FracDigits || psXPC->f.radix) ? 1 : 0 ;
+	int32_t	Len = Sign + IntDigits + (psXPC->f.group ? (IntDigits - 1) / 3 : 0) + Radix + FracDigits + ExpLen ;
+	int32_t	Pad = (psXPC->f.minwid > Len) ? psXPC->f.minwid - Len : 0 ;
+
+	// stream it out: [pad] [sign] [0pad] int [.frac] [exp] [pad]
+	char	Buffer[32] ;
+	int		Idx = 0 ;
+	#define	xpfF64_PUT(c)	{ Buffer[Idx++] = (c) ; if (Idx == sizeof(Buffer)) { vPrintSpan(psXPC, Buffer, Idx) ; Idx = 0 ; } }
+	if (psXPC->f.ljust == 0 && psXPC->f.pad0 == 0) vPrintRepeat(psXPC, ' ', Pad) ;
+	if (Sign) xpfF64_PUT(psXPC->f.negvalue ? '-' : '+') ;
+	if (psXPC->f.ljust == 0 && psXPC->f.pad0) {
+		vPrintSpan(psXPC, Buffer, Idx) ;
+		Idx = 0 ;
+		vPrintRepeat(psXPC, '0', Pad) ;
+	}
+	int32_t	Pos = 0 ;										// index into rounded digits
+	if (FracPos <= 0) {
+		xpfF64_PUT('0') ;
+	} else {
+		for (int32_t Cnt = IntDigits; Cnt > 0; --Cnt) {
+			xpfF64_PUT('0' + xPrintDigitRounded(&sD, &sR, Pos++)) ;
+			if (psXPC->f.group && Cnt > 1 && (Cnt % 3) == 1) xpfF64_PUT(',') ;
+		}
+	}
+	if (Radix) xpfF64_PUT('.') ;
+	for (int32_t Cnt = 0; Cnt < FracDigits; ++Cnt) {
+		int32_t Rel = FracPos + Cnt ;
+		xpfF64_PUT((Rel < 0 || Rel >= sR.Count) ? '0' : '0' + xPrintDigitRounded(&sD, &sR, Pos++)) ;
+	}
+	#undef	xpfF64_PUT
+	vPrintSpan(psXPC, Buffer, Idx) ;
+	if (ExpLen) vPrintSpan(psXPC, &ExpBuf[sizeof(ExpBuf) - ExpLen], ExpLen) ;
+	if (psXPC->f.ljust) vPrintRepeat(psXPC, ' ', Pad) ;
+}
+#endif
+
+/* Hex byte kernel, converts Num bytes to 2 x Num hex characters. 16 bytes at a time with SSE2 or
+ * NEON when available, else 4 bytes at a time SWAR style, each nibble spread into its own byte
+ * with '0' added and the A-F adjustment selected by the carry out of (nibble + 6). All source loads
+ * are unaligned safe (loadu / vld1q / memcpy). SWAR store order relies on little endian, as does
+ * the xpfFLAG_* guard in printfx.h */
+#if		defined(__SSE2__)
+	#include	<emmintrin.h>
+#elif	defined(__ARM_NEON)
+	#include	<arm_neon.h>
+#endif
+
+static	char *	pcPrintHexBytes(char * pDst, const uint8_t * pSrc, int Num, int Ucase) {
+	const uint8_t Adj = Ucase ? 'A' - '9' - 1 : 'a' - '9' - 1 ;
+#if		defined(__SSE2__)
+	const __m128i Mask = _mm_set1_epi8(0x0F) ;
+	const __m128i Nine = _mm_set1_epi8(9) ;
+	const __m128i Zero = _mm_set1_epi8('0') ;
+	const __m128i Alfa = _mm_set1_epi8(Adj) ;
+	for (; Num >= 16; Num -= 16, pSrc += 16, pDst += 32) {
+		__m128i Val = _mm_loadu_si128((const __m128i *) pSrc) ;
+		__m128i Hi	= _mm_and_si128(_mm_srli_epi16(Val, 4), Mask) ;
+		__m128i Lo	= _mm_and_si128(Val, Mask) ;
+		__m128i N0	= _mm_unpacklo_epi8(Hi, Lo) ;
+		__m128i N1	= _mm_unpackhi_epi8(Hi, Lo) ;
+		N0 = _mm_add_epi8(_mm_add_epi8(N0, Zero), _mm_and_si128(_mm_cmpgt_epi8(N0, Nine), Alfa)) ;
+		N1 = _mm_add_epi8(_mm_add_epi8(N1, Zero), _mm_and_si128(_mm_cmpgt_epi8(N1, Nine), Alfa)) ;
+		_mm_storeu_si128((__m128i *) pDst, N0) ;
+		_mm_storeu_si128((__m128i *) (pDst + 16), N1) ;
+	}
+#elif	defined(__ARM_NEON)
+	const uint8x16_t Mask = vdupq_n_u8(0x0F) ;
+	const uint8x16_t Nine = vdupq_n_u8(9) ;
+	const uint8x16_t Zero = vdupq_n_u8('0') ;
+	const uint8x16_t Alfa = vdupq_n_u8(Adj) ;
+	for (; Num >= 16; Num -= 16, pSrc += 16, pDst += 32) {
+		uint8x16_t	Val = vld1q_u8(pSrc) ;
+		uint8x16x2_t Nib ;
+		Nib.val[0] = vshrq_n_u8(Val, 4) ;
+		Nib.val[1] = vandq_u8(Val, Mask) ;
+		Nib.val[0] = vaddq_u8(vaddq_u8(Nib.val[0], Zero), vandq_u8(vcgtq_u8(Nib.val[0], Nine), Alfa)) ;
+		Nib.val[1] = vaddq_u8(vaddq_u8(Nib.val[1], Zero), vandq_u8(vcgtq_u8(Nib.val[1], Nine), Alfa)) ;
+		vst2q_u8((uint8_t *) pDst, Nib) ;				// interleaves Hi/Lo nibbles
+	}
+#endif
+	for (; Num >= 4; Num -= 4, pSrc += 4, pDst += 8) {
+		uint32_t U32 ;
+		memcpy(&U32, pSrc, sizeof(U32)) ;
+		uint64_t Val = U32 ;							// byte i => bits 16i..16i+7
+		Val = (Val | (Val << 16)) & 0x0000FFFF0000FFFFULL ;
+		Val = (Val | (Val << 8)) & 0x00FF00FF00FF00FFULL ;
+		Val = ((Val >> 4) & 0x000F000F000F000FULL) | ((Val & 0x000F000F000F000FULL) << 8) ;
+		uint64_t Alf = ((Val + 0x0606060606060606ULL) >> 4) & 0x0101010101010101ULL ;
+		Val += 0x3030303030303030ULL + (Alf * Adj) ;
+		memcpy(pDst, &Val, sizeof(Val)) ;
+	}
+	const char * pcHex = Ucase ? hexchars : hexlower ;
+	for (; Num > 0; --Num, ++pSrc) {
+		*pDst++ = pcHex[*pSrc >> 4] ;
+		*pDst++ = pcHex[*pSrc & 0x0F] ;
+	}
+	return pDst ;
 }
 
 /**
- * vPrintHexValues() - write series of char values as hex chars to the buffer, always NULL terminated
+ * xPrintHexRow() - build series of 8/16/32/64 bit values as hex chars in the buffer, NOT terminated
  * @param psXPC
- * @param Num		number of bytes to print
- * @param pStr		pointer to bytes to print
+ * @param Num		number of bytes to convert, at most xpfHEXDUMP_WIDTH
+ * @param pStr		pointer to bytes to convert, no alignment requirement
+ * @param pBuf		buffer to build in, at least xpfHEXDUMP_WIDTH * 3 characters
+ * @return			number of characters built
  * @comment			Use the following modifier flags
  *					'`'	select grouping separators ':' (byte) '-' (short) ' ' (word) '|' (dword)
  *					'#' via alt_form select reverse order (little vs big endian) interpretation
+ *					A trailing partial value is zero filled, never read beyond Num bytes.
  */
-void	vPrintHexValues(xpc_t * psXPC, int Num, char * pStr) {
-	int32_t	Size = 1 << psXPC->f.size ;
-	if (psXPC->f.alt_form)								// '#' specified to invert order ?
-		pStr += Num - Size ;							// working backwards so point to last
-
-	x64_t	x64Val ;
-	int32_t	Idx	= 0 ;
-	while (Idx < Num) {
-		switch (psXPC->f.size) {
-		case 0:
-			x64Val.x8[0].u8	  = *((uint8_t *) pStr) ;
-			vPrintHexU8(psXPC, x64Val.x8[0].u8) ;
-			break ;
-		case 1:
-			x64Val.x16[0].u16 = *((uint16_t *) pStr) ;
-			vPrintHexU16(psXPC, x64Val.x16[0].u16) ;
-			break ;
-		case 2:
-			x64Val.x32[0].u32 = *((uint32_t *) pStr) ;
-			vPrintHexU32(psXPC, x64Val.x32[0].u32) ;
-			break ;
-		case 3:
-			x64Val.u64	  = *((uint64_t *) pStr) ;
-			vPrintHexU64(psXPC, x64Val.u64) ;
-			break ;
-		}
-		// step to the next 8/16/32/64 bit value
-		if (psXPC->f.alt_form)							// '#' specified to invert order ?
-			pStr -= Size ;								// update source pointer backwards
-		else
-			pStr += Size ;								// update source pointer forwards
-		Idx += Size ;
-		if (Idx >= Num) {
-			break ;
+static	int	xPrintHexRow(xpc_t * psXPC, int Num, const uint8_t * pStr, char * pBuf) {
+	IF_myASSERT(debugPARAM, Num <= xpfHEXDUMP_WIDTH) ;
+	if (Num <= 0)
+		return 0 ;
+	int	Size = 1 << psXPC->f.size ;
+	int	Vals = (Num + Size - 1) / Size ;
+	uint8_t	Disp[xpfHEXDUMP_WIDTH + sizeof(uint64_t)] = { 0 } ;
+	const uint8_t * pSrc = pStr ;
+	if (Size > 1 || psXPC->f.alt_form) {				// collect bytes in display order, MSB first
+		for (int Val = 0; Val < Vals; ++Val) {
+			int Idx = psXPC->f.alt_form ? Vals - 1 - Val : Val ;
+			int Cnt = Num - (Idx * Size) ;
+			Cnt = Cnt > Size ? Size : Cnt ;
+			uint8_t * pDst = &Disp[(Val + 1) * Size] ;
+			for (int Byte = 0; Byte < Size; ++Byte)	// little endian value, reverse the bytes
+				*--pDst = Byte < Cnt ? pStr[(Idx * Size) + Byte] : 0 ;
 		}
-		// now handle the grouping separator(s) if any
-		if (psXPC->f.form == form0G)				// no separator required?
-			continue ;
-		vPrintChar(psXPC, psXPC->f.form == form1F ? ':' :
+		pSrc = Disp ;
+	}
+	if (psXPC->f.form == form0G)						// no separators, straight into buffer
+		return pcPrintHexBytes(pBuf, pSrc, Vals * Size, psXPC->f.Ucase) - pBuf ;
+
+	char	Hex[(xpfHEXDUMP_WIDTH + sizeof(uint64_t)) * 2] ;
+	pcPrintHexBytes(Hex, pSrc, Vals * Size, psXPC->f.Ucase) ;
+	int Len = 0 ;
+	for (int Val = 0; Val < Vals; ++Val) {
+		if (Val) {
+			int Idx = Val * Size ;
+			pBuf[Len++] = psXPC->f.form == form1F ? ':' :
 						  psXPC->f.form == form2E ? '-' :
 						  psXPC->f.form == form3X ? (
 							(Idx % 8) == 0 ? ' ' :
 							(Idx % 4) == 0 ? '|' :
-							(Idx % 2) == 0 ? '-' : ':' ) : '?') ;
+							(Idx % 2) == 0 ? '-' : ':' ) : '?' ;
+		}
+		memcpy(&pBuf[Len], &Hex[Val * Size * 2], Size * 2) ;
+		Len += Size * 2 ;
+	}
+	return Len ;
+}
+
+/**
+ * vPrintHexValues() - write series of char values as hex chars, single span per call
+ * @param psXPC
+ * @param Num		number of bytes to print
+ * @param pStr		pointer to bytes to print
+ */
+void	vPrintHexValues(xpc_t * psXPC, int Num, char * pStr) {
+	char	Buffer[xpfHEXDUMP_WIDTH * 3] ;
+	while (Num > 0) {
+		int Now = Num > xpfHEXDUMP_WIDTH ? xpfHEXDUMP_WIDTH : Num ;
+		vPrintSpan(psXPC, Buffer, xPrintHexRow(psXPC, Now, (const uint8_t *) pStr, Buffer)) ;
+		pStr += Now ;
+		Num -= Now ;
 	}
 }
 
+/**
+ * xPrintAddress() - build 32 bit address as "0x12345678" in the buffer, NOT terminated
+ * \param[in]	psXPC - pointer to print control structure
+ * \param[in]	pVoid - address to be converted, currently 64 bit addresses not supported
+ * \param[in]	pBuf - buffer to build in, at least 10 characters
+ * \return		number of characters built
+ */
+static	int	xPrintAddress(xpc_t * psXPC, void * pVoid, char * pBuf) {
+	uint32_t Addr = (uint32_t) (uintptr_t) pVoid ;
+	uint8_t	Bytes[sizeof(uint32_t)] = { Addr >> 24, Addr >> 16, Addr >> 8, Addr } ;
+	pBuf[0] = '0' ;
+	pBuf[1] = 'x' ;
+	return pcPrintHexBytes(pBuf + 2, Bytes, sizeof(Bytes), psXPC->f.Ucase) - pBuf ;
+}
+
 // ############################### Proprietary extensions to printf() ##############################
 
 /**
@@ -478,8 +1192,8 @@ void	vPrintHexValues(xpc_t * psXPC, int Num, char * pStr) {
  * \return		none
  */
 void vPrintPointer(xpc_t * psXPC, void * pVoid) {
-	xPrintChars(psXPC, (char *) "0x") ;
-	vPrintHexU32(psXPC, (uint32_t) pVoid) ;
+	char	Buffer[sizeof("0x12345678")] ;
+	vPrintSpan(psXPC, Buffer, xPrintAddress(psXPC, pVoid, Buffer)) ;
 }
 
 seconds_t xPrintCalcSeconds(xpc_t * psXPC, TSZ_t * psTSZ, struct tm * psTM) {
@@ -498,7 +1212,15 @@ seconds_t xPrintCalcSeconds(xpc_t * psXPC, TSZ_t * psTSZ, struct tm * psTM) {
 	return Seconds ;
 }
 
+/**
+ * xPrintTimeCalcSize() - set the minimum width of a date/time component & size its buffer
+ * \return	characters required, more than 2 for a relative day count above 99
+ */
 int	xPrintTimeCalcSize(xpc_t * psXPC, int i32Val) {
+	if (i32Val > 99) {									// relative days, maybe grouped
+		psXPC->f.minwid = 2 ;
+		return xDigitsInI32(i32Val, psXPC->f.group) ;
+	}
 	if (!psXPC->f.rel_val || psXPC->f.pad0 || i32Val > 9) return psXPC->f.minwid = 2 ;
 	psXPC->f.minwid = 1 ;
 	return xDigitsInI32(i32Val, psXPC->f.group) ;
@@ -506,7 +1228,10 @@ int	xPrintTimeCalcSize(xpc_t * psXPC, int i32Val) {
 
 int	xPrintDate_Year(xpc_t * psXPC, struct tm * psTM, char * pBuffer) {
 	psXPC->f.minwid	= 0 ;
+	int Group = psXPC->f.group ;						// selects form3X, year is never grouped
+	psXPC->f.group	= 0 ;
 	int Len = xPrintXxx(psXPC, (uint64_t) (psTM->tm_year + YEAR_BASE_MIN), pBuffer, 4) ;
+	psXPC->f.group	= Group ;
 	if (psXPC->f.alt_form == 0)	pBuffer[Len++] = (psXPC->f.form == form3X) ? '/' : '-' ;
 	return Len ;
 }
@@ -580,7 +1305,10 @@ void vPrintTime(xpc_t * psXPC, struct tm * psTM, uint32_t uSecs) {
 		psXPC->f.pad0	= 1 ;						// need leading '0's
 		psXPC->f.signval= 0 ;
 		psXPC->f.ljust	= 0 ;						// force R-just
+		int Group		= psXPC->f.group ;			// selects form3X, fraction is never grouped
+		psXPC->f.group	= 0 ;
 		Len += xPrintXxx(psXPC, uSecs, Buffer+Len, psXPC->f.minwid	= psXPC->f.precis) ;
+		psXPC->f.group	= Group ;
 	} else if (psXPC->f.form == form3X) {
 		Buffer[Len++]	= 's' ;
 	}
@@ -683,50 +1411,152 @@ void vPrintURL(xpc_t * psXPC, char * pStr) {
 }
 
 /**
- * vPrintHexDump()
- * \brief		Dumps a block of memory in debug style format. depending on options output can be
- * 				formatted as 8/16/32 or 64 bit variables, optionally with no, absolute or relative address
+ * vPrintHexDumpRow()
+ * \brief		Build a single hexdump row (address, values, ASCII & newline) and output as 1 span
  * \param[in]	psXPC - pointer to print control structure
- * \param[in]	pStr - pointer to memory starting address
- * \param[in]	Len - Length/size of memory buffer to display
- * \param[out]	none
+ * \param[in]	pRow - pointer to the (at most xpfHEXDUMP_WIDTH) bytes to display
+ * \param[in]	Width - number of bytes in this row
+ * \param[in]	pAddr - absolute address or relative offset to display, based on rel_val
+ * \param[in]	Multi - part of a multi row dump, pad ASCII to line up and terminate with newline
  * \return		none
- * \comment		Use the following modifier flags
- *				'`'		Grouping of values using ' ' '-' or '|' as separators
- * 				'!'		Use relative address format
- * 				'#'		Use absolute address format
- *						Relative/absolute address prefixed using format '0x12345678:'
- * 				'+'		Add the ASCII char equivalents to the right of the hex output
  */
-void vPrintHexDump(xpc_t * psXPC, int Siz, char * pStr) {
-	for (int Now = 0; Now < Siz; Now += xpfHEXDUMP_WIDTH) {
+static	void vPrintHexDumpRow(xpc_t * psXPC, const char * pRow, int Width, void * pAddr, int Multi) {
+	char	Row[xpfMAX_LEN_DUMP] ;						// complete row built, then output as 1 span
+	int		Len = 0 ;
 #if		(xpfSUPPORT_POINTER == 1)
-		if (psXPC->f.ljust == 0) {						// display absolute or relative address
-			vPrintPointer(psXPC, psXPC->f.rel_val ? (void *) Now : (void *)(pStr + Now)) ;
-			xPrintChars(psXPC, (char *) ": ") ;
-		}
+	if (psXPC->f.ljust == 0) {							// display absolute or relative address
+		Len = xPrintAddress(psXPC, pAddr, Row) ;
+		Row[Len++] = ':' ;
+		Row[Len++] = ' ' ;
+	}
 #endif
-		// then the actual series of values in 8-32 bit groups
+	// then the actual series of values in 8-32 bit groups
+	Len += xPrintHexRow(psXPC, Width, (const uint8_t *) pRow, &Row[Len]) ;
+	if (psXPC->f.plus == 1) {							// handle values dumped as ASCII chars
+	// handle space padding for ASCII dump to line up
+		int Size = 1 << psXPC->f.size ;
+		int Count = Multi ? ((xpfHEXDUMP_WIDTH - Width) / Size) * ((Size * 2) + (psXPC->f.form ? 1 : 0)) + 1 : 1 ;
+		memset(&Row[Len], ' ', Count) ;
+		Len += Count ;
+		// handle same values dumped as ASCII characters
+		for (Count = 0; Count < Width; ++Count) {
+			uint8_t cChr = pRow[Count] ;
+		#if 0											// Device supports characters in range 0x80 to 0xFE
+			Row[Len++] = (cChr < ' ' || cChr == 0x7F || cChr == 0xFF) ? '.' : cChr ;
+		#else											// Device does NOT support ANY characters > 0x7E
+			Row[Len++] = (cChr < ' ' || cChr >= 0x7F) ? '.' : cChr ;
+		#endif
+		}
+		Row[Len++] = ' ' ;
+	}
+	if (Multi) Row[Len++] = '\n' ;
+	vPrintSpan(psXPC, Row, Len) ;
+}
+
+/**
+ * vPrintHexDumpForm() - set value size & separator form of a B/H/W hexdump from the modifier flags
+ */
+static	void vPrintHexDumpForm(xpc_t * psXPC, int cFmt) {
+	psXPC->f.form	= psXPC->f.group ? form3X : form0G ;
+	psXPC->f.size	= cFmt == 'B' ? xpfSIZING_BYTE : cFmt == 'H' ? xpfSIZING_SHORT : xpfSIZING_WORD ;
+	psXPC->f.size	+= psXPC->f.llong ? 1 : 0 ; 		// apply ll modifier to size
+}
+
+/**
+ * vPrintHexDump()
+ * \brief		Dumps a block of memory in debug style format. depending on options output can be
+ * 				formatted as 8/16/32 or 64 bit variables, optionally with no, absolute or relative address
+ * \param[in]	psXPC - pointer to print control structure
+ * \param[in]	Siz - Length/size of memory buffer to display
+ * \param[in]	pStr - pointer to memory starting address
+ * \param[in]	pAddr - absolute address displayed for pStr, differs if a deferred copy
+ * \param[out]	none
+ * \return		none
+ * \comment		Use the following modifier flags
+ *				'`'		Grouping of values using ' ' '-' or '|' as separators
+ * 				'!'		Use relative address format
+ * 				'#'		Use absolute address format
+ *						Relative/absolute address prefixed using format '0x12345678:'
+ * 				'+'		Add the ASCII char equivalents to the right of the hex output
+ * 				'='		Collapse runs of identical rows into a single '*' line, last row always shown
+ */
+void vPrintHexDump(xpc_t * psXPC, int Siz, char * pStr, char * pAddr) {
+	int	Skip = 0 ;
+	for (int Now = 0; Now < Siz; Now += xpfHEXDUMP_WIDTH) {
 		int Width = (Siz - Now) > xpfHEXDUMP_WIDTH ? xpfHEXDUMP_WIDTH : Siz - Now ;
-		vPrintHexValues(psXPC, Width, pStr + Now) ;
-		if (psXPC->f.plus == 1) {						// handle values dumped as ASCII chars
-		// handle space padding for ASCII dump to line up
-			uint32_t	Count ;
-			int	Size = 1 << psXPC->f.size ;
-			Count = (Siz > xpfHEXDUMP_WIDTH) ? ((xpfHEXDUMP_WIDTH - Width) / Size) * ((Size * 2) + (psXPC->f.form ? 1 : 0)) + 1 : 1 ;
-			while (Count--)	vPrintChar(psXPC, ' ') ;
-			// handle same values dumped as ASCII characters
-			for (Count = 0; Count < Width; ++Count) {
-				uint32_t cChr = *(pStr + Now + Count) ;
-			#if 0										// Device supports characters in range 0x80 to 0xFE
-				vPrintChar(psXPC, (cChr < ' ' || cChr == 0x7F || cChr == 0xFF) ? '.' : cChr) ;
-			#else										// Device does NOT support ANY characters > 0x7E
-				vPrintChar(psXPC, (cChr < ' ' || cChr >= 0x7F) ? '.' : cChr) ;
-			#endif
-			}
-			vPrintChar(psXPC, ' ') ;
+		if (psXPC->f.squeeze && Now && (Siz - Now) > xpfHEXDUMP_WIDTH &&
+			memcmp(pStr + Now, pStr + Now - xpfHEXDUMP_WIDTH, xpfHEXDUMP_WIDTH) == 0) {
+			if (Skip == 0) vPrintSpan(psXPC, "*\n", 2) ;	// 1st of a run of identical rows
+			Skip = 1 ;
+			continue ;
+		}
+		Skip = 0 ;
+		vPrintHexDumpRow(psXPC, pStr + Now, Width, psXPC->f.rel_val ? (void *) (uintptr_t) Now : (void *) (pAddr + Now), Siz > xpfHEXDUMP_WIDTH) ;
+	}
+}
+
+/**
+ * vPrintDumpInit()
+ * \brief		Initialise a streaming hexdump context before feeding the first chunk via %Y
+ * \param[in]	psXPD - pointer to context to initialise
+ * \param[in]	Size - value size, xpfSIZING_BYTE/SHORT/WORD/DWORD
+ * \return		none
+ */
+void vPrintDumpInit(xpd_t * psXPD, int Size) {
+	IF_myASSERT(debugPARAM, INRANGE(xpfSIZING_BYTE, Size, xpfSIZING_DWORD, int)) ;
+	memset(psXPD, 0, sizeof(xpd_t)) ;
+	psXPD->Size = Size ;
+}
+
+/**
+ * vPrintHexStream()
+ * \brief		Continue a hexdump across chunks, complete rows are output straight from the chunk,
+ * 				only an incomplete trailing row (< xpfHEXDUMP_WIDTH bytes) is held in the context.
+ * 				Rows are addressed as if all chunks were a single contiguous buffer.
+ * \param[in]	psXPC - pointer to print control structure
+ * \param[in]	psXPD - pointer to streaming context, see vPrintDumpInit()
+ * \param[in]	Siz - number of bytes in this chunk, 0 to flush any incomplete row
+ * \param[in]	pStr - pointer to chunk
+ * \param[in]	pAddr - absolute address displayed for pStr, differs if a deferred copy
+ * \return		none
+ * \comment		Same modifier flags as vPrintHexDump(), every row terminated with a newline
+ */
+void vPrintHexStream(xpc_t * psXPC, xpd_t * psXPD, int Siz, char * pStr, char * pAddr) {
+	if (Siz == 0) {										// flush incomplete row, if any
+		if (psXPD->Fill) {
+			vPrintHexDumpRow(psXPC, (char *) psXPD->Row, psXPD->Fill,
+				psXPC->f.rel_val ? (void *) (uintptr_t) psXPD->Offset : (void *) psXPD->pcRow, 1) ;
+			psXPD->Offset += psXPD->Fill ;
+			psXPD->Fill = 0 ;
 		}
-		if (Now < Siz && Siz > xpfHEXDUMP_WIDTH) xPrintChars(psXPC, (char *) "\n");
+		return ;
+	}
+	ptrdiff_t	Bias = pAddr - pStr ;
+	if (psXPD->Fill) {									// complete the held row first
+		int Now = xpfHEXDUMP_WIDTH - psXPD->Fill ;
+		Now = Now > Siz ? Siz : Now ;
+		memcpy(&psXPD->Row[psXPD->Fill], pStr, Now) ;
+		psXPD->Fill += Now ;
+		pStr += Now ;
+		Siz -= Now ;
+		if (psXPD->Fill < xpfHEXDUMP_WIDTH)
+			return ;
+		vPrintHexDumpRow(psXPC, (char *) psXPD->Row, xpfHEXDUMP_WIDTH,
+			psXPC->f.rel_val ? (void *) (uintptr_t) psXPD->Offset : (void *) psXPD->pcRow, 1) ;
+		psXPD->Offset += xpfHEXDUMP_WIDTH ;
+		psXPD->Fill = 0 ;
+	}
+	while (Siz >= xpfHEXDUMP_WIDTH) {					// complete rows directly from the chunk
+		vPrintHexDumpRow(psXPC, pStr, xpfHEXDUMP_WIDTH,
+			psXPC->f.rel_val ? (void *) (uintptr_t) psXPD->Offset : (void *) (pStr + Bias), 1) ;
+		psXPD->Offset += xpfHEXDUMP_WIDTH ;
+		pStr += xpfHEXDUMP_WIDTH ;
+		Siz -= xpfHEXDUMP_WIDTH ;
+	}
+	if (Siz) {											// hold the incomplete tail
+		memcpy(psXPD->Row, pStr, Siz) ;
+		psXPD->pcRow = pStr + Bias ;
+		psXPD->Fill = Siz ;
 	}
 }
 
@@ -794,7 +1624,7 @@ void vPrintIpAddress(xpc_t * psXPC, uint32_t Val) {
 
 	// then convert the IP address, LSB first
 	int	Idx, Len ;
-	for (Idx = 0, Len = 0; Idx < sizeof(Val); ++Idx) {
+	for (Idx = 0, Len = 0; Idx < (int) sizeof(Val); ++Idx) {
 		uint64_t u64Val = (uint8_t) pChr[Idx] ;
 		Len += xPrintXxx(psXPC, u64Val, Buffer + xpfMAX_LEN_IP - 5 - Len, 4) ;
 		if (Idx < 3) Buffer[xpfMAX_LEN_IP - 1 - ++Len] = '.';
@@ -817,426 +1647,1440 @@ void vPrintSetGraphicRendition(xpc_t * psXPC, uint32_t Val) {
 	if (pcANSIattrib(Buffer, sSGR.a, sSGR.b) != Buffer) xPrintChars(psXPC, Buffer) ;
 }
 
-/* ################################# The HEART of the PRINTFX matter ###############################
- * PrintFX - common routine for formatted print functionality
- * \brief	parse the format string and interpret the conversions, flags and modifiers
- * 			extract the parameters variables in correct type format
- * 			call the correct routine(s) to perform conversion, formatting & output
- * \param	psXPC - pointer to structure containing formatting and output destination info
- * 			format - pointer to the formatting string
- * 			vArgs - variable number of arguments
- * \return	void (other than updated info in the original structure passed by reference
+// ################################ Format parsing & conversion dispatch ###########################
+
+#if		(xpfSUPPORT_ARRAYS == 1)
+/**
+ * pcPrintParseArray()
+ * \brief	parse the array modifier "[{count|*}[b|h|w|l][separator]]", up to 2 separator characters
+ * \param	psOp - pointer to the instruction being initialised
+ * 			fmt - pointer to the first character following the '['
+ * \return	pointer to the first character following the ']'
  */
+static	const char * pcPrintParseArray(xpo_t * psOp, const char * fmt) {
+	static const char SizeChr[] = "bhwl" ;
+	psOp->Args |= xpoARG_ARRAY ;
+	if (*fmt == '*') {
+		psOp->Args |= xpoARG_COUNT ;
+		++fmt ;
+	} else {
+		while (sPrintClass[(uint8_t) *fmt] & xpcDIGIT) psOp->Count = (psOp->Count * 10) + (*fmt++ - '0') ;
+	}
+	const char * pSiz = *fmt ? strchr(SizeChr, *fmt) : NULL ;
+	if (pSiz) {
+		psOp->Args |= xpoARR_SIZED | ((pSiz - SizeChr) << xpoARR_SHIFT) ;
+		++fmt ;
+	}
+	for (size_t Idx = 0; *fmt && *fmt != ']'; ++fmt) {
+		if (Idx < sizeof(psOp->Sep)) psOp->Sep[Idx++] = *fmt ;
+	}
+	IF_myASSERT(debugTRACK, *fmt == ']') ;
+	return (*fmt == ']') ? fmt + 1 : fmt ;
+}
 
-int	xpcprintfx(xpc_t * psXPC, const char * fmt, va_list vArgs) {
-	for (; *fmt != 0; ++fmt) {
-	// start by expecting format indicator
-		if (*fmt == '%') {
-			psXPC->f.flags 	= 0 ;						// set ALL flags to default 0
-			psXPC->f.limits	= 0 ;						// reset field specific limits
-			psXPC->f.nbase	= BASE10 ;					// default number base
-			++fmt ;
-			if (*fmt == 0) break;
-			/* In order for the optional modifiers to work correctly, especially in cases such as HEXDUMP
-			 * the modifiers MUST be in correct sequence of interpretation being [ ! # ' * + - % 0 ] */
-			int	cFmt ;
-			int Siz = 0 ;
-			while ((cFmt = xinstring("!#'*+- 0%", *fmt)) != erFAILURE) {
-				switch (cFmt) {
-				case 0:									// '!' HEXDUMP absolute->relative address
-					++fmt ;								// DTZ absolute->relative time
-					psXPC->f.rel_val = 1 ;				// MAC use ':' separator
-					break ;
-				case 1:									// '#' DTZ alternative form
-					++fmt ;								// HEXDUMP / IP swop endian
-					psXPC->f.alt_form = 1 ;				// STRING middle justify
-					break ;
-				case 2:									// "'" decimal= ',' separated 3 digit grouping
-					++fmt ;								// DTZ=alternate format
-					psXPC->f.group = 1 ;
-					break ;
-				case 3:									// '*' indicate argument will supply field width
-					Siz	= va_arg(vArgs, int) ;
-					IF_myASSERT(debugTRACK, psXPC->f.arg_width == 0 && Siz <= xpfMINWID_MAXVAL) ;
-					++fmt ;
-					psXPC->f.minwid = Siz ;
-					psXPC->f.arg_width = 1 ;
-					break ;
-				case 4:									// '+' force leading +/- signed
-					++fmt ;								// or HEXDUMP add ASCII char dump
-					psXPC->f.plus = 1 ;					// or TIME add TZ info
-					break ;
-				case 5:									// '-' Left justify modifier
-					++fmt ;								// or HEXDUMP remove address pointer
-					psXPC->f.ljust = 1 ;
-					break ;
-				case 6:									// ' ' instead of '+'
-					++fmt ;
-					psXPC->f.Pspc = 1 ;
-					break ;
-				case 7:									// '0 force leading '0's
-					++fmt ;
-					psXPC->f.pad0 = 1 ;
-					break ;
-				default:								// '%' literal to display
-					goto out_lbl ;
-				}
-			}
-			// handle pre and post decimal field width/precision indicators
-			if (*fmt == '.' || INRANGE('0', *fmt, '9', char)) {
-				Siz = 0 ;
-				while (1) {
-					if (INRANGE('0', *fmt, '9', char)) {
-						Siz *= 10 ;
-						Siz += *fmt - '0' ;
-						++fmt ;
-					} else if (*fmt == '.') {
-						IF_myASSERT(debugTRACK, psXPC->f.radix == 0) ;//  2x radix not allowed
-						++fmt ;
-						psXPC->f.radix = 1 ;
-						if (Siz > 0) {
-							IF_myASSERT(debugTRACK, psXPC->f.arg_width == 0 && Siz <= xpfMINWID_MAXVAL) ;
-							psXPC->f.minwid = Siz ;
-							psXPC->f.arg_width = 1 ;
-							Siz = 0 ;
-						}
-					} else if (*fmt == '*') {
-						IF_myASSERT(debugTRACK, psXPC->f.radix == 1 && Siz == 0) ;
-						++fmt ;
-						Siz	= va_arg(vArgs, int) ;
-						IF_myASSERT(debugTRACK, Siz <= xpfPRECIS_MAXVAL) ;
-						psXPC->f.precis = Siz ;
-						psXPC->f.arg_prec = 1 ;
-						Siz = 0 ;
-					} else {
-						break ;
-					}
-				}
-				// Save possible parsed value in cFmt
+/**
+ * xPrintArraySize() - size of each array element, as specified else by conversion
+ */
+static	int	xPrintArraySize(const xpo_t * psOp) {
+	if (psOp->Args & xpoARR_SIZED) return 1 << ((psOp->Args & xpoARR_MASK) >> xpoARR_SHIFT) ;
+	if (psOp->cFmt == CHR_e || psOp->cFmt == CHR_f || psOp->cFmt == CHR_g || psOp->cFmt == CHR_a)
+		return sizeof(double) ;
+	xpf_t	f ;
+	f.flags = psOp->flags ;
+	return f.llong ? sizeof(uint64_t) : sizeof(uint32_t) ;
+}
+
+/**
+ * xPrintArrayValid() - array modifier only with a numeric conversion, float elements 32/64 bit
+ * 		Same rules as xPrintCheckArgs() in printfx.hpp applies at compile time
+ */
+static	int	xPrintArrayValid(const xpo_t * psOp, int cFmt) {
+	if (cFmt == CHR_e || cFmt == CHR_f || cFmt == CHR_g || cFmt == CHR_a)
+		return (xpfSUPPORT_IEEE754 == 1) &&
+			((psOp->Args & xpoARR_SIZED) == 0 || ((psOp->Args & xpoARR_MASK) >> xpoARR_SHIFT) >= 2) ;
+#if		(xpfSUPPORT_BINARY == 1)
+	if (cFmt == CHR_J) return 1 ;
+#endif
+	return cFmt == CHR_d || cFmt == CHR_i || cFmt == CHR_o || cFmt == CHR_x || cFmt == CHR_u ;
+}
+#endif
+
+/**
+ * pcPrintParseSpec()
+ * \brief	parse the modifiers, field width/precision, size and conversion character following a '%'
+ * 			into a conversion template. No arguments are consumed, '*' width/precision are recorded
+ * \param	psOp - pointer to the instruction to be initialised
+ * 			fmt - pointer to the first character following the '%'
+ * \return	pointer to the conversion character, the terminating NUL if none (an empty literal, callers
+ * 			end the format there without executing it)
+ */
+const char * pcPrintParseSpec(xpo_t * psOp, const char * fmt) {
+	xpf_t	f ;
+	f.flags		= 0 ;										// set ALL flags to default 0
+	f.limits	= 0 ;										// reset field specific limits
+	f.nbase		= BASE10 ;									// default number base
+	psOp->Args	= 0 ;
+#if		(xpfSUPPORT_ARRAYS == 1)
+	psOp->Count	= 0 ;
+	psOp->Sep[0] = psOp->Sep[1] = 0 ;
+	if (*fmt == '[') fmt = pcPrintParseArray(psOp, fmt + 1) ;
+#endif
+	/* In order for the optional modifiers to work correctly, especially in cases such as HEXDUMP
+	 * the modifiers MUST be in correct sequence of interpretation being [ ! # ' * + - % 0 = ] */
+	int	cFmt ;
+	int Siz = 0 ;
+	while ((cFmt = sPrintClass[(uint8_t) *fmt] & xpcMOD_MASK) != xpcNONE) {
+		if (cFmt == xpcPCNT) {								// '%' literal to display
+			psOp->cFmt	= 0 ;
+			psOp->pcLit	= fmt ;
+			psOp->Len	= 1 ;
+			return fmt ;
+		}
+		IF_myASSERT(debugTRACK, cFmt != xpcSTAR || f.arg_width == 0) ;
+		f.flags		|= sPrintModFlag[cFmt] ;
+		psOp->Args	|= (cFmt == xpcSTAR) ? xpoARG_WIDTH : 0 ;
+		++fmt ;
+	}
+	// handle pre and post decimal field width/precision indicators
+	if (*fmt == '.' || (sPrintClass[(uint8_t) *fmt] & xpcDIGIT)) {
+		Siz = 0 ;
+		while (1) {
+			if (sPrintClass[(uint8_t) *fmt] & xpcDIGIT) {
+				Siz *= 10 ;
+				Siz += *fmt - '0' ;
+				++fmt ;
+			} else if (*fmt == '.') {
+				IF_myASSERT(debugTRACK, f.radix == 0) ;	//  2x radix not allowed
+				++fmt ;
+				f.radix = 1 ;
 				if (Siz > 0) {
-					if (psXPC->f.arg_width == 0 && psXPC->f.radix == 0) {
-						IF_myASSERT(debugTRACK, Siz <= xpfMINWID_MAXVAL) ;
-						psXPC->f.minwid	= Siz ;
-						psXPC->f.arg_width = 1 ;
-					} else if (psXPC->f.arg_prec == 0 && psXPC->f.radix == 1) {
-						IF_myASSERT(debugTRACK, Siz <= xpfPRECIS_MAXVAL) ;
-						psXPC->f.precis	= Siz ;
-						psXPC->f.arg_prec = 1 ;
-					} else {
-						IF_myASSERT(debugTRACK, 0) ;
-					}
+					IF_myASSERT(debugTRACK, f.arg_width == 0 && Siz <= xpfMINWID_MAXVAL) ;
+					f.minwid = Siz ;
+					f.arg_width = 1 ;
+					Siz = 0 ;
 				}
+			} else if (*fmt == '*') {
+				IF_myASSERT(debugTRACK, f.radix == 1 && Siz == 0) ;
+				++fmt ;
+				psOp->Args |= xpoARG_PRECIS ;
+				f.arg_prec = 1 ;
+				Siz = 0 ;
+			} else {
+				break ;
 			}
-			// handle 2x successive 'l' characters, lower case ONLY, form long long value treatment
-			if (*fmt == 'l' && *(fmt+1) == 'l') {
-				fmt += 2 ;
-				psXPC->f.llong = 1 ;
-			}
-			// Check if format character where UC/lc same character control the case of the output
-			cFmt = *fmt ;
-			if (xinstring(vPrintStr1, cFmt) != erFAILURE) {
-				cFmt |= 0x20 ;							// convert to lower case, but ...
-				psXPC->f.Ucase = 1 ;					// indicate as UPPER case requested
+		}
+		// Save possible parsed value in cFmt
+		if (Siz > 0) {
+			if (f.arg_width == 0 && f.radix == 0) {
+				IF_myASSERT(debugTRACK, Siz <= xpfMINWID_MAXVAL) ;
+				f.minwid	= Siz ;
+				f.arg_width = 1 ;
+			} else if (f.arg_prec == 0 && f.radix == 1) {
+				IF_myASSERT(debugTRACK, Siz <= xpfPRECIS_MAXVAL) ;
+				f.precis	= Siz ;
+				f.arg_prec = 1 ;
+			} else {
+				IF_myASSERT(debugTRACK, 0) ;
 			}
+		}
+	}
+	// handle 2x successive 'l' characters, lower case ONLY, form long long value treatment
+	if (*fmt == 'l' && *(fmt+1) == 'l') {
+		fmt += 2 ;
+		f.llong = 1 ;
+	}
+	// Check if format character where UC/lc same character control the case of the output
+	cFmt = *fmt ;
+	if (cFmt == 0) {									// '%' ending the format, empty literal
+		psOp->cFmt	= 0 ;
+		psOp->pcLit	= fmt ;
+		psOp->Len	= 0 ;
+		return fmt ;
+	}
+	if (sPrintClass[(uint8_t) cFmt] & xpcUCASE) {
+		cFmt |= 0x20 ;									// convert to lower case, but ...
+		f.Ucase = 1 ;									// indicate as UPPER case requested
+	}
+#if		(xpfSUPPORT_ARRAYS == 1)
+	if ((psOp->Args & xpoARG_ARRAY) && xPrintArrayValid(psOp, cFmt) == 0)
+		psOp->Args |= xpoARR_INVALID ;					// arguments consumed, nothing converted
+#endif
+	psOp->cFmt		= cFmt ;
+	psOp->limits	= f.limits ;
+	psOp->flags		= f.flags ;
+	return fmt ;
+}
+
+/* Argument fetch, from the va_list or from a deferred record (see vPrintDeferredV) where values
+ * are packed unaligned and a pointer to data is followed by a U16 length and a copy of the data.
+ * xpfARG_DATA() yields the data for a pointer already fetched, the copy if deferred. Packed by
+ * reference (Refs, see xpcprintfx_packed) the pointers are used as is, nothing follows them.
+ * xpfARG_COPY() as xpfARG_DATA() for a structure, an unaligned deferred copy is moved to *ps */
+#if		(xpfSUPPORT_DEFERRED == 1) || (xpfSUPPORT_PACKED == 1)
+	#define	xpfARG(psA, T)			((psA)->pArgs ? ({ T _V ; memcpy(&_V, (psA)->pArgs, sizeof(T)) ; (psA)->pArgs += sizeof(T) ; _V ; }) : va_arg((psA)->vArgs, T))
+	#define	xpfARG_DATA(psA, p)		(((psA)->pArgs && (psA)->Refs == 0) ? pvPrintArgData(psA) : (void *) (p))
+	#define	xpfARG_COPY(psA, p, ps)	(((psA)->pArgs && (psA)->Refs == 0) ? memcpy((ps), pvPrintArgData(psA), sizeof(*(ps))) : (void *) (p))
+
+static	void * pvPrintArgData(xpa_t * psArgs) {
+	uint16_t	Len ;
+	memcpy(&Len, psArgs->pArgs, sizeof(Len)) ;
+	void * pVoid = Len ? (void *) (psArgs->pArgs + sizeof(Len)) : NULL ;
+	psArgs->pArgs += sizeof(Len) + Len ;
+	return pVoid ;
+}
+#else
+	#define	xpfARG(psA, T)			va_arg((psA)->vArgs, T)
+	#define	xpfARG_DATA(psA, p)		((void *) (p))
+	#define	xpfARG_COPY(psA, p, ps)	((void *) (p))
+#endif
+
+/**
+ * vPrintValue()
+ * \brief	format & output a numeric value already fetched, single argument or array element
+ * \param	psXPC - pointer to structure containing formatting and output destination info
+ * 			cFmt - conversion character, one of 'J', 'd', 'i', 'o', 'x', 'u', 'e', 'f', 'a' or 'g'
+ * 			x64Val - value, i64 if signed, f64 if floating point else u64
+ * \return	none
+ */
+static	void vPrintValue(xpc_t * psXPC, int cFmt, x64_t x64Val) {
+	switch (cFmt) {
+#if		(xpfSUPPORT_BINARY == 1)
+	case CHR_J:
+		vPrintBinary(psXPC, x64Val.u64) ;
+		break ;
+#endif
+
+	case CHR_d:
+	case CHR_i:
+		psXPC->f.signval = 1 ;
+		if (x64Val.i64 < 0LL)	{
+			psXPC->f.negvalue	= 1 ;
+			x64Val.i64 		*= -1 ; 		// convert the value to unsigned
+		}
+		vPrintX64(psXPC, x64Val.i64) ;
+		break ;
+
+	case CHR_o:
+	case CHR_x:
+		psXPC->f.group = 0 ;					// disable grouping
+		/* FALLTHRU */ /* no break */
+	case CHR_u:
+		psXPC->f.nbase = cFmt == 'x' ? BASE16 : cFmt == 'o' ? BASE08 : BASE10 ;
+		vPrintX64(psXPC, x64Val.u64) ;
+		break ;
+
+#if		(xpfSUPPORT_IEEE754 == 1)
+	case CHR_e:									// form = 2
+		psXPC->f.form++ ;
+		/* FALLTHRU */ /* no break */
+	case CHR_f:									// form = 1
+		psXPC->f.form++ ;
+		/* FALLTHRU */ /* no break */
+	case CHR_a:									// stopgap, HEX format no supported
+	case CHR_g:									// form = 0
+		psXPC->f.signval = 1 ;					// float always signed value.
+		/* https://en.cppreference.com/w/c/io/fprintf
+		 * https://pubs.opengroup.org/onlinepubs/007908799/xsh/fprintf.html
+		 * https://docs.microsoft.com/en-us/cpp/c-runtime-library/format-specification-syntax-printf-and-wprintf-functions?view=msvc-160
+		 */
+		if (psXPC->f.arg_prec == 0) {			// no explicit precision specified ?
+			psXPC->f.precis	= xpfDEFAULT_DECIMALS ;
+		}
+		vPrintF64(psXPC, x64Val.f64) ;
+		break ;
+#endif
+
+	default:
+		myASSERT(0) ;
+		break ;
+	}
+}
 
-			x64_t	x64Val ;							// default x64 variable
-			px_t	px ;
+/**
+ * vPrintConvert()
+ * \brief	fetch the argument(s) for a single conversion and call the routine(s) to perform
+ * 			the conversion, formatting & output. Flags & limits must already be set up in psXPC
+ * \param	psXPC - pointer to structure containing formatting and output destination info
+ * 			cFmt - conversion character, lower case where UC/lc selected by Ucase flag
+ * 			psArgs - pointer to argument source
+ * \return	none
+ */
+void	vPrintConvert(xpc_t * psXPC, int cFmt, xpa_t * psArgs) {
+	x64_t	x64Val ;										// default x64 variable
+	px_t	px ;
+	char *	pcStr ;
+	int		Siz ;
+#if		(xpfSUPPORT_HEXDUMP == 1)
+	xpd_t *	psXPD ;
+#endif
 #if		(xpfSUPPORT_DATETIME == 1)
-			struct	tm 	sTM ;
-			TSZ_t * psTSZ ;
+	struct	tm 	sTM ;
+	TSZ_t * psTSZ ;
+	TSZ_t	sArgTSZ ;									// aligned copy of deferred TSZ_t
 #endif
 
-			switch (cFmt) {
+	switch (cFmt) {
 #if		(xpfSUPPORT_SGR == 1)
-			/* XXX: Since we are using the same command handler to process (UART, HTTP & TNET)
-			 * requests, and we are embedding colour ESC sequences into the formatted output,
-			 * and the colour ESC sequences (handled by UART & TNET) are not understood by
-			 * the HTTP protocol, we must try to filter out the possible output produced by
-			 * the ESC sequences if the output is going to a socket, one way or another.
-			 */
-			case CHR_C:
-				vPrintSetGraphicRendition(psXPC, va_arg(vArgs, uint32_t)) ;
-				break ;
+	/* XXX: Since we are using the same command handler to process (UART, HTTP & TNET)
+	 * requests, and we are embedding colour ESC sequences into the formatted output,
+	 * and the colour ESC sequences (handled by UART & TNET) are not understood by
+	 * the HTTP protocol, we must try to filter out the possible output produced by
+	 * the ESC sequences if the output is going to a socket, one way or another.
+	 */
+	case CHR_C:
+		vPrintSetGraphicRendition(psXPC, xpfARG(psArgs, uint32_t)) ;
+		break ;
 #endif
 
 #if		(xpfSUPPORT_IP_ADDR == 1)						// IP address
-			case CHR_I:
-				vPrintIpAddress(psXPC, va_arg(vArgs, uint32_t)) ;
-				break ;
+	case CHR_I:
+		vPrintIpAddress(psXPC, xpfARG(psArgs, uint32_t)) ;
+		break ;
 #endif
 
 #if		(xpfSUPPORT_BINARY == 1)
-			case CHR_J:
-				x64Val.u64 = psXPC->f.llong ? va_arg(vArgs, uint64_t) : (uint64_t) va_arg(vArgs, uint32_t) ;
-				vPrintBinary(psXPC, x64Val.u64) ;
-				break ;
+	case CHR_J:
+		x64Val.u64 = psXPC->f.llong ? xpfARG(psArgs, uint64_t) : (uint64_t) xpfARG(psArgs, uint32_t) ;
+		vPrintValue(psXPC, cFmt, x64Val) ;
+		break ;
 #endif
 
 #if		(xpfSUPPORT_DATETIME == 1)
-			/* Prints date and/or time in POSIX format
-			 * Use the following modifier flags
-			 *	'`'		select between 2 different separator sets being
-			 *			'/' or '-' (years)
-			 *			'/' or '-' (months)
-			 *			'T' or ' ' (days)
-			 *			':' or 'h' (hours and minutes)
-			 *			'.' or 's' (seconds)
-			 * 	'!'		Treat time value as elapsed and not epoch [micro] seconds
-			 * 	'.'		append 1 -> 6 digit(s) fractional seconds
-			 * Norm 1	1970/01/01T00:00:00Z
-			 * Norm 2	1970-01-01 00h00m00s
-			 * Altform	Mon, 01 Jan 1970 00:00:00 GMT
-			 */
-			case CHR_D:				// epoch (psTSZ) DATE
-				IF_myASSERT(debugTRACK, !psXPC->f.rel_val && !psXPC->f.group) ;
-				psXPC->f.pad0 = 1 ;
-				psTSZ = va_arg(vArgs, TSZ_t *) ;
-				IF_myASSERT(debugTRACK, halCONFIG_inMEM(psTSZ)) ;
-				xPrintCalcSeconds(psXPC, psTSZ, &sTM) ;
-				vPrintDate(psXPC, &sTM) ;
-				vPrintZone(psXPC, psTSZ) ;
-				break ;
-
-			case CHR_R:				// U64 epoch (yr+mth+day) OR relative (days) + TIME
-				IF_myASSERT(debugTRACK, !psXPC->f.plus && !psXPC->f.pad0 && !psXPC->f.group) ;
-				if (psXPC->f.alt_form) {
-					psXPC->f.group = 1 ;
-					psXPC->f.alt_form = 0 ;
-				}
-				if (!psXPC->f.rel_val) {
-					psXPC->f.pad0 = 1 ;
-				}
-				x64Val.u64 = va_arg(vArgs, uint64_t) ;
-				vPrintDateTime(psXPC, x64Val.u64) ;
-				break ;
-
-			case CHR_T:				// psTSZ epoch TIME
-				IF_myASSERT(debugTRACK, !psXPC->f.rel_val && !psXPC->f.group) ;
-				psXPC->f.pad0 = 1 ;
-				psTSZ = va_arg(vArgs, TSZ_t *) ;
-				IF_myASSERT(debugTRACK, halCONFIG_inMEM(psTSZ)) ;
-				xPrintCalcSeconds(psXPC, psTSZ, &sTM) ;
-				vPrintTime(psXPC, &sTM, (uint32_t) (psTSZ->usecs % MICROS_IN_SECOND)) ;
-				vPrintZone(psXPC, psTSZ) ;
-				break ;
-
-			case CHR_Z:				// psTSZ epoch DATE+TIME+ZONE
-				IF_myASSERT(debugTRACK, !psXPC->f.rel_val && !psXPC->f.plus && !psXPC->f.group) ;
-				psXPC->f.pad0 = 1 ;
-				psXPC->f.no_zone = 1 ;
-				uint32_t flags = psXPC->f.flags ;
-				psTSZ = va_arg(vArgs, TSZ_t *) ;
-				IF_myASSERT(debugTRACK, halCONFIG_inMEM(psTSZ)) ;
-				vPrintDateTime(psXPC, xTimeMakeTimestamp(xPrintCalcSeconds(psXPC, psTSZ, NULL), psTSZ->usecs % MICROS_IN_SECOND)) ;
-				psXPC->f.flags = flags ;
-				vPrintZone(psXPC, psTSZ) ;
-				break ;
+	/* Prints date and/or time in POSIX format
+	 * Use the following modifier flags
+	 *	'`'		select between 2 different separator sets being
+	 *			'/' or '-' (years)
+	 *			'/' or '-' (months)
+	 *			'T' or ' ' (days)
+	 *			':' or 'h' (hours and minutes)
+	 *			'.' or 's' (seconds)
+	 * 	'!'		Treat time value as elapsed and not epoch [micro] seconds
+	 * 	'.'		append 1 -> 6 digit(s) fractional seconds
+	 * Norm 1	1970/01/01T00:00:00Z
+	 * Norm 2	1970-01-01 00h00m00s
+	 * Altform	Mon, 01 Jan 1970 00:00:00 GMT
+	 */
+	case CHR_D:				// epoch (psTSZ) DATE
+		IF_myASSERT(debugTRACK, !psXPC->f.rel_val && !psXPC->f.group) ;
+		psXPC->f.pad0 = 1 ;
+		psTSZ = xpfARG(psArgs, TSZ_t *) ;
+		IF_myASSERT(debugTRACK, halCONFIG_inMEM(psTSZ)) ;
+		psTSZ = xpfARG_COPY(psArgs, psTSZ, &sArgTSZ) ;
+		xPrintCalcSeconds(psXPC, psTSZ, &sTM) ;
+		vPrintDate(psXPC, &sTM) ;
+		vPrintZone(psXPC, psTSZ) ;
+		break ;
 
-			case CHR_r:				// U32->U64 epoch (yr+mth+day) or relative (days) + TIME
-				IF_myASSERT(debugTRACK, !psXPC->f.alt_form && !psXPC->f.plus && !psXPC->f.pad0 && !psXPC->f.radix && !psXPC->f.group) ;
-				psXPC->f.pad0 = 1 ;
-				x64Val.u64 = (uint64_t) va_arg(vArgs, uint32_t) * MILLION ;
-				vPrintDateTime(psXPC, x64Val.u64) ;
-				break ;
+	case CHR_R:				// U64 epoch (yr+mth+day) OR relative (days) + TIME
+		IF_myASSERT(debugTRACK, !psXPC->f.plus && !psXPC->f.pad0 && !psXPC->f.group) ;
+		if (psXPC->f.alt_form) {
+			psXPC->f.group = 1 ;
+			psXPC->f.alt_form = 0 ;
+		}
+		if (!psXPC->f.rel_val) {
+			psXPC->f.pad0 = 1 ;
+		}
+		x64Val.u64 = xpfARG(psArgs, uint64_t) ;
+		vPrintDateTime(psXPC, x64Val.u64) ;
+		break ;
+
+	case CHR_T:				// psTSZ epoch TIME
+		IF_myASSERT(debugTRACK, !psXPC->f.rel_val && !psXPC->f.group) ;
+		psXPC->f.pad0 = 1 ;
+		psTSZ = xpfARG(psArgs, TSZ_t *) ;
+		IF_myASSERT(debugTRACK, halCONFIG_inMEM(psTSZ)) ;
+		psTSZ = xpfARG_COPY(psArgs, psTSZ, &sArgTSZ) ;
+		xPrintCalcSeconds(psXPC, psTSZ, &sTM) ;
+		vPrintTime(psXPC, &sTM, (uint32_t) (psTSZ->usecs % MICROS_IN_SECOND)) ;
+		vPrintZone(psXPC, psTSZ) ;
+		break ;
+
+	case CHR_Z:				// psTSZ epoch DATE+TIME+ZONE
+		IF_myASSERT(debugTRACK, !psXPC->f.rel_val && !psXPC->f.plus && !psXPC->f.group) ;
+		psXPC->f.pad0 = 1 ;
+		psXPC->f.no_zone = 1 ;
+		uint32_t flags = psXPC->f.flags ;
+		psTSZ = xpfARG(psArgs, TSZ_t *) ;
+		IF_myASSERT(debugTRACK, halCONFIG_inMEM(psTSZ)) ;
+		psTSZ = xpfARG_COPY(psArgs, psTSZ, &sArgTSZ) ;
+		vPrintDateTime(psXPC, xTimeMakeTimestamp(xPrintCalcSeconds(psXPC, psTSZ, NULL), psTSZ->usecs % MICROS_IN_SECOND)) ;
+		psXPC->f.flags = flags ;
+		vPrintZone(psXPC, psTSZ) ;
+		break ;
+
+	case CHR_r:				// U32->U64 epoch (yr+mth+day) or relative (days) + TIME
+		IF_myASSERT(debugTRACK, !psXPC->f.alt_form && !psXPC->f.plus && !psXPC->f.pad0 && !psXPC->f.radix && !psXPC->f.group) ;
+		psXPC->f.pad0 = 1 ;
+		x64Val.u64 = (uint64_t) xpfARG(psArgs, uint32_t) * MILLION ;
+		vPrintDateTime(psXPC, x64Val.u64) ;
+		break ;
 #endif
 
 #if		(xpfSUPPORT_URL == 1)							// para = pointer to string to be encoded
-			case CHR_U:
-				px.pc8	= va_arg(vArgs, char *) ;
-				IF_myASSERT(debugTRACK, halCONFIG_inMEM(px.pc8)) ;
-				vPrintURL(psXPC, px.pc8) ;
-				break ;
+	case CHR_U:
+		px.pc8	= xpfARG(psArgs, char *) ;
+		IF_myASSERT(debugTRACK, halCONFIG_inMEM(px.pc8)) ;
+		vPrintURL(psXPC, xpfARG_DATA(psArgs, px.pc8)) ;
+		break ;
 #endif
 
 #if		(xpfSUPPORT_HEXDUMP == 1)
-			case CHR_B:									// HEXDUMP 8bit sized
-			case CHR_H:									// HEXDUMP 16bit sized
-			case CHR_W:									// HEXDUMP 32bit sized
-				IF_myASSERT(debugTRACK, !psXPC->f.arg_width && !psXPC->f.arg_prec) ;
-				/* In order for formatting to work  the "*" or "." radix specifiers
-				 * should not be used. The requirement for a second parameter is implied and assumed */
-				psXPC->f.form	= psXPC->f.group ? form3X : form0G ;
-				psXPC->f.size = cFmt == 'B' ? xpfSIZING_BYTE : cFmt == 'H' ? xpfSIZING_SHORT : xpfSIZING_WORD ;
-				psXPC->f.size	+= psXPC->f.llong ? 1 : 0 ; 	// apply ll modifier to size
-				Siz	= va_arg(vArgs, int) ;
-				px.pc8	= va_arg(vArgs, char *) ;
-				IF_myASSERT(debugTRACK, halCONFIG_inMEM(px.pc8)) ;
-				vPrintHexDump(psXPC, Siz, px.pc8) ;
-				break ;
+	case CHR_B:									// HEXDUMP 8bit sized
+	case CHR_H:									// HEXDUMP 16bit sized
+	case CHR_W:									// HEXDUMP 32bit sized
+		IF_myASSERT(debugTRACK, !psXPC->f.arg_width && !psXPC->f.arg_prec) ;
+		/* In order for formatting to work  the "*" or "." radix specifiers
+		 * should not be used. The requirement for a second parameter is implied and assumed */
+		vPrintHexDumpForm(psXPC, cFmt) ;
+		Siz	= xpfARG(psArgs, int) ;
+		px.pc8	= xpfARG(psArgs, char *) ;
+		IF_myASSERT(debugTRACK, halCONFIG_inMEM(px.pc8)) ;
+		vPrintHexDump(psXPC, Siz, xpfARG_DATA(psArgs, px.pc8), px.pc8) ;
+		break ;
+
+	case CHR_Y:									// HEXDUMP continued from context, size set by context
+		IF_myASSERT(debugTRACK, !psXPC->f.arg_width && !psXPC->f.arg_prec) ;
+		psXPD	= xpfARG(psArgs, xpd_t *) ;
+		IF_myASSERT(debugTRACK, halCONFIG_inMEM(psXPD)) ;
+	#if		(xpfSUPPORT_DEFERRED == 1)
+		if (psArgs->pArgs && psArgs->Refs == 0) ++psArgs->pArgs ;	// captured value size, for the host decoder
+	#endif
+		psXPC->f.form	= psXPC->f.group ? form3X : form0G ;
+		psXPC->f.size	= psXPD->Size ;
+		Siz	= xpfARG(psArgs, int) ;
+		px.pc8	= xpfARG(psArgs, char *) ;
+		IF_myASSERT(debugTRACK, Siz == 0 || halCONFIG_inMEM(px.pc8)) ;
+		vPrintHexStream(psXPC, psXPD, Siz, xpfARG_DATA(psArgs, px.pc8), px.pc8) ;
+		break ;
 #endif
 
 #if		(xpfSUPPORT_MAC_ADDR == 1)
-			/* Formats 6 byte string (0x00 is valid) as a series of hex characters.
-			 * default format uses no separators eg. '0123456789AB'
-			 * Support the following modifier flags:
-			 *  '!'	select ':' separator between digits
-			 */
-			case CHR_m:									// MAC address UC/LC format ??:??:??:??:??:??
-				IF_myASSERT(debugTRACK, !psXPC->f.arg_width && !psXPC->f.arg_prec) ;
-				psXPC->f.size	= 0 ;
-				psXPC->f.llong	= 0 ;					// force interpretation as sequence of U8 values
-				psXPC->f.form	= psXPC->f.group ? form1F : form0G ;
-				px.pc8	= va_arg(vArgs, char *) ;
-				IF_myASSERT(debugTRACK, halCONFIG_inMEM(px.pc8)) ;
-				vPrintHexValues(psXPC, lenMAC_ADDRESS, px.pc8) ;
-				break ;
+	/* Formats 6 byte string (0x00 is valid) as a series of hex characters.
+	 * default format uses no separators eg. '0123456789AB'
+	 * Support the following modifier flags:
+	 *  '!'	select ':' separator between digits
+	 */
+	case CHR_m:									// MAC address UC/LC format ??:??:??:??:??:??
+		IF_myASSERT(debugTRACK, !psXPC->f.arg_width && !psXPC->f.arg_prec) ;
+		psXPC->f.size	= 0 ;
+		psXPC->f.llong	= 0 ;					// force interpretation as sequence of U8 values
+		psXPC->f.form	= psXPC->f.group ? form1F : form0G ;
+		px.pc8	= xpfARG(psArgs, char *) ;
+		IF_myASSERT(debugTRACK, halCONFIG_inMEM(px.pc8)) ;
+		vPrintHexValues(psXPC, lenMAC_ADDRESS, xpfARG_DATA(psArgs, px.pc8)) ;
+		break ;
 #endif
 
-			case CHR_c:
-				x64Val.x32[0].i32 = va_arg(vArgs, int32_t) ;
-				vPrintChar(psXPC, x64Val.x32[0].i32) ;
-				break ;
-
-			case CHR_d:									// signed decimal "[-]ddddd"
-			case CHR_i:									// signed integer (same as decimal ?)
-				psXPC->f.signval = 1 ;
-				x64Val.i64	= psXPC->f.llong ? va_arg(vArgs, int64_t) : va_arg(vArgs, int32_t) ;
-				if (x64Val.i64 < 0LL)	{
-					psXPC->f.negvalue	= 1 ;
-					x64Val.i64 		*= -1 ; 		// convert the value to unsigned
-				}
-				vPrintX64(psXPC, x64Val.i64) ;
-				break ;
-
-			case CHR_o:									// unsigned octal "ddddd"
-			case CHR_x:									// hex as in "789abcd" UC/LC
-				psXPC->f.group = 0 ;					// disable grouping
-				/* FALLTHRU */ /* no break */
-			case CHR_u:									// unsigned decimal "ddddd"
-				x64Val.u64	= psXPC->f.llong ? va_arg(vArgs, uint64_t) : va_arg(vArgs, uint32_t) ;
-				psXPC->f.nbase = cFmt == 'x' ? BASE16 : cFmt == 'o' ? BASE08 : BASE10 ;
-				vPrintX64(psXPC, x64Val.u64) ;
-				break ;
+	case CHR_c:
+		x64Val.x32[0].i32 = xpfARG(psArgs, int32_t) ;
+		vPrintChar(psXPC, x64Val.x32[0].i32) ;
+		break ;
+
+	case CHR_d:									// signed decimal "[-]ddddd"
+	case CHR_i:									// signed integer (same as decimal ?)
+		x64Val.i64	= psXPC->f.llong ? xpfARG(psArgs, int64_t) : xpfARG(psArgs, int32_t) ;
+		vPrintValue(psXPC, cFmt, x64Val) ;
+		break ;
+
+	case CHR_o:									// unsigned octal "ddddd"
+	case CHR_x:									// hex as in "789abcd" UC/LC
+	case CHR_u:									// unsigned decimal "ddddd"
+		x64Val.u64	= psXPC->f.llong ? xpfARG(psArgs, uint64_t) : xpfARG(psArgs, uint32_t) ;
+		vPrintValue(psXPC, cFmt, x64Val) ;
+		break ;
+
+#if		(xpfSUPPORT_FIXEDPOINT == 1)
+	case CHR_Q:									// binary scaled (Q format) value
+	case CHR_q:									// decimal scaled value
+		Siz = xpfARG(psArgs, int) ;			// number of fraction bits or digits
+		x64Val.i64	= psXPC->f.llong ? xpfARG(psArgs, int64_t) : xpfARG(psArgs, int32_t) ;
+		vPrintFixed(psXPC, x64Val.i64, Siz, cFmt == CHR_Q) ;
+		break ;
+#endif
 
 #if		(xpfSUPPORT_IEEE754 == 1)
-			case CHR_e:									// form = 2
-				psXPC->f.form++ ;
-				/* FALLTHRU */ /* no break */
-			case CHR_f:									// form = 1
-				psXPC->f.form++ ;
-				/* FALLTHRU */ /* no break */
-			case CHR_a:									// stopgap, HEX format no supported
-			case CHR_g:									// form = 0
-				psXPC->f.signval = 1 ;					// float always signed value.
-				/* https://en.cppreference.com/w/c/io/fprintf
-				 * https://pubs.opengroup.org/onlinepubs/007908799/xsh/fprintf.html
-				 * https://docs.microsoft.com/en-us/cpp/c-runtime-library/format-specification-syntax-printf-and-wprintf-functions?view=msvc-160
-				 */
-				if (psXPC->f.arg_prec) {				// explicit precision specified ?
-					psXPC->f.precis = psXPC->f.precis > xpfMAXIMUM_DECIMALS ? xpfMAXIMUM_DECIMALS : psXPC->f.precis ;
-				} else {
-					psXPC->f.precis	= xpfDEFAULT_DECIMALS ;
-				}
-				x64Val.f64 = va_arg(vArgs, double) ;
-				vPrintF64(psXPC, x64Val.f64) ;
-				break ;
+	case CHR_e:
+	case CHR_f:
+	case CHR_a:
+	case CHR_g:
+		x64Val.f64 = xpfARG(psArgs, double) ;
+		vPrintValue(psXPC, cFmt, x64Val) ;
+		break ;
 #endif
 
 #if		(xpfSUPPORT_POINTER == 1)						// pointer value UC/lc
-			case CHR_p:
-				px.pv = va_arg(vArgs, void *) ;
-				// Does cause crash if pointer not currently mapped
+	case CHR_p:
+		px.pv = xpfARG(psArgs, void *) ;
+		// Does cause crash if pointer not currently mapped
 //				IF_myASSERT(debugTRACK, halCONFIG_inMEM(pVoid)) ;
-				vPrintPointer(psXPC, px.pv) ;
-				break ;
+		vPrintPointer(psXPC, px.pv) ;
+		break ;
 #endif
 
-			case CHR_s:
-				px.pv = va_arg(vArgs, char *) ;
-				// Required to avoid crash when wifi message is intercepted and a string pointer parameter
-				// is evaluated as out of valid memory address (0xFFFFFFE6). Replace string with "pOOR"
-				px.pc8 = halCONFIG_inMEM(px.pc8) ? px.pc8 : px.pc8 == NULL ? STRING_NULL : STRING_OOR ;
-				vPrintString(psXPC, px.pc8) ;
-				break;
-
-			case CHR_b:							// Unsupported types to be filtered.
-			case CHR_h:
-			case CHR_w:
-				myASSERT(0) ;
-				break ;
+	case CHR_s:
+		px.pc8 = xpfARG(psArgs, char *) ;
+		// Required to avoid crash when wifi message is intercepted and a string pointer parameter
+		// is evaluated as out of valid memory address (0xFFFFFFE6). Replace string with "pOOR"
+		pcStr = xpfARG_DATA(psArgs, halCONFIG_inMEM(px.pc8) ? px.pc8 : NULL) ;
+		px.pc8 = pcStr ? pcStr : px.pc8 == NULL ? STRING_NULL : STRING_OOR ;
+		psXPC->f.stable = 1 ;					// argument, sink may reference rather than copy
+		vPrintString(psXPC, px.pc8) ;
+		psXPC->f.stable = 0 ;
+		break;
+
+	case CHR_b:							// Unsupported types to be filtered.
+	case CHR_h:
+	case CHR_w:
+		myASSERT(0) ;
+		break ;
+
+	default:
+		/* At this stage we have handled the '%' as assumed, but the next character found is invalid.
+		 * Show the '%' we swallowed and then the extra, invalid, character as well */
+		vPrintChar(psXPC, '%') ;
+		vPrintChar(psXPC, cFmt) ;
+		break ;
+	}
+}
 
-			default:
-				/* At this stage we have handled the '%' as assumed, but the next character found is invalid.
-				 * Show the '%' we swallowed and then the extra, invalid, character as well */
-				vPrintChar(psXPC, '%') ;
-				vPrintChar(psXPC, *fmt) ;
-				break ;
-			}
-			psXPC->f.plus				= 0 ;		// reset this form after printing one value
-		} else {
-out_lbl:
-			vPrintChar(psXPC, *fmt) ;
+#if		(xpfSUPPORT_ARRAYS == 1)
+/**
+ * vPrintArray()
+ * \brief	apply a single numeric conversion to each element of an array, in one pass
+ * \param	psXPC - pointer to structure, flags & limits of the conversion set up
+ * 			psOp - pointer to instruction with array modifier
+ * 			Count - number of elements
+ * 			pElem - pointer to the first element
+ * \return	none
+ */
+static	void vPrintArray(xpc_t * psXPC, const xpo_t * psOp, int Count, const uint8_t * pElem) {
+	int		Size = xPrintArraySize(psOp) ;
+	int		Signed = (psOp->cFmt == CHR_d || psOp->cFmt == CHR_i) ;
+	int		Float = (psOp->cFmt == CHR_e || psOp->cFmt == CHR_f || psOp->cFmt == CHR_g || psOp->cFmt == CHR_a) ;
+	uint32_t limits = psXPC->f.limits ;
+	x64_t	x64Val ;
+	for (int Idx = 0; Idx < Count; ++Idx, pElem += Size) {
+		if (Idx && psOp->Sep[0]) {
+			vPrintChar(psXPC, psOp->Sep[0]) ;
+			if (psOp->Sep[1]) vPrintChar(psXPC, psOp->Sep[1]) ;
+		}
+		switch (Size) {									// elements need not be aligned
+		case 1:	x64Val.i64 = Signed ? (int64_t) *(int8_t *) pElem : (int64_t) *pElem ;	break ;
+		case 2: { uint16_t V ; memcpy(&V, pElem, sizeof(V)) ; x64Val.i64 = Signed ? (int64_t) (int16_t) V : (int64_t) V ; break ; }
+		case 4: { uint32_t V ; memcpy(&V, pElem, sizeof(V)) ;
+				if (Float) {
+					float F ;
+					memcpy(&F, &V, sizeof(F)) ;
+					x64Val.f64 = F ;
+				} else {
+					x64Val.i64 = Signed ? (int64_t) (int32_t) V : (int64_t) V ;
+				}
+				break ; }
+		default: memcpy(&x64Val.u64, pElem, sizeof(uint64_t)) ; break ;
 		}
+		psXPC->f.flags	= psOp->flags ;					// conversion may change flags & limits
+		psXPC->f.limits	= limits ;
+		vPrintValue(psXPC, psOp->cFmt, x64Val) ;
 	}
-	return psXPC->f.curlen ;
 }
+#endif
 
-int	xprintfx(int (Hdlr)(xpc_t *, int), void * pVoid, size_t szBuf, const char * fmt, va_list vArgs) {
-	xpc_t	sXPC ;
-	sXPC.handler	= Hdlr ;
-	sXPC.pVoid		= pVoid ;
-	sXPC.f.maxlen	= (szBuf > xpfMAXLEN_MAXVAL) ? xpfMAXLEN_MAXVAL : szBuf ;
-	sXPC.f.curlen	= 0 ;
-	return xpcprintfx(&sXPC, fmt, vArgs) ;
+/**
+ * vPrintOp()
+ * \brief	execute a single instruction, literal span or conversion
+ * \param	psXPC - pointer to structure containing formatting and output destination info
+ * 			psOp - pointer to instruction
+ * 			psArgs - pointer to argument source
+ * \return	none
+ */
+void	vPrintOp(xpc_t * psXPC, const xpo_t * psOp, xpa_t * psArgs) {
+	if (psOp->cFmt == 0) {
+		vPrintSpanRef(psXPC, psOp->pcLit, psOp->Len) ;
+		return ;
+	}
+	psXPC->f.limits	= psOp->limits ;
+	psXPC->f.flags	= psOp->flags ;
+#if		(xpfSUPPORT_ARRAYS == 1)
+	int Count = (psOp->Args & xpoARG_COUNT) ? xpfARG(psArgs, int) : psOp->Count ;
+#endif
+	if (psOp->Args & xpoARG_WIDTH) {						// '*' field width from argument
+		int Siz = xpfARG(psArgs, int) ;
+		IF_myASSERT(debugTRACK, Siz <= xpfMINWID_MAXVAL) ;
+		psXPC->f.minwid = Siz ;
+	}
+	if (psOp->Args & xpoARG_PRECIS) {						// '.*' precision from argument
+		int Siz = xpfARG(psArgs, int) ;
+		IF_myASSERT(debugTRACK, Siz <= xpfPRECIS_MAXVAL) ;
+		psXPC->f.precis = Siz ;
+	}
+#if		(xpfSUPPORT_ARRAYS == 1)
+	if (psOp->Args & xpoARG_ARRAY) {
+		const uint8_t * pElem = xpfARG(psArgs, const uint8_t *) ;
+		IF_myASSERT(debugTRACK, Count == 0 || halCONFIG_inMEM(pElem)) ;
+	#if		(xpfSUPPORT_DEFERRED == 1)
+		if (psArgs->pArgs && psArgs->Refs == 0) {		// only the captured elements
+			uint16_t Len ;
+			memcpy(&Len, psArgs->pArgs, sizeof(Len)) ;
+			if (Count > Len / xPrintArraySize(psOp)) Count = Len / xPrintArraySize(psOp) ;
+		}
+	#endif
+		pElem = xpfARG_DATA(psArgs, pElem) ;
+		if (psOp->Args & xpoARR_INVALID) {				// as for an invalid conversion character
+			vPrintChar(psXPC, '%') ;
+			vPrintChar(psXPC, psOp->cFmt) ;
+			return ;
+		}
+		vPrintArray(psXPC, psOp, Count, pElem) ;
+		return ;
+	}
+#endif
+	vPrintConvert(psXPC, psOp->cFmt, psArgs) ;
 }
 
-// ##################################### Destination = STRING ######################################
+/* ################################# The HEART of the PRINTFX matter ###############################
+ * PrintFX - common routine for formatted print functionality
+ * \brief	parse the format string and interpret the conversions, flags and modifiers
+ * 			extract the parameters variables in correct type format
+ * 			call the correct routine(s) to perform conversion, formatting & output
+ * \param	psXPC - pointer to structure containing formatting and output destination info
+ * 			format - pointer to the formatting string
+ * 			psArgs - pointer to argument source, va_list or deferred record
+ * \return	void (other than updated info in the original structure passed by reference
+ */
 
-int	xPrintToString(xpc_t * psXPC, int cChr) {
-	if (psXPC->pStr) *psXPC->pStr++ = cChr;
-	return cChr ;
+static	int	xPrintFormat(xpc_t * psXPC, const char * fmt, xpa_t * psArgs) {
+	xpo_t	sOp ;
+	while (*fmt != 0) {
+		if (*fmt == '%') {
+			fmt = pcPrintParseSpec(&sOp, fmt + 1) ;
+			if (*fmt == 0) break ;						// '%' ending the format
+			vPrintOp(psXPC, &sOp, psArgs) ;
+			++fmt ;
+		} else {										// emit the literal run up to the next '%' as a single span
+			const char * pRun = fmt ;
+			fmt = pcPrintNextSpec(fmt + 1) ;
+			vPrintSpanRef(psXPC, pRun, fmt - pRun) ;
+		}
+	}
+	return psXPC->f.curlen ;
 }
 
-int vsnprintfx(char * pBuf, size_t szBuf, const char * format, va_list vArgs) {
-	if (szBuf == 1) {									// no space ?
-		if (pBuf) *pBuf = 0 ;							// yes, terminate
-		return 0 ; 										// & return
-	}
-	int iRV = xprintfx(xPrintToString, pBuf, szBuf, format, vArgs) ;
-	if (pBuf) {											// Buffer specified ?
-		if (iRV == szBuf) --iRV ;						// make space for terminator
-		pBuf[iRV] = 0 ;									// terminate
-	}
+int	xpcprintfx(xpc_t * psXPC, const char * fmt, va_list vArgs) {
+	xpa_t	sArgs ;
+	va_copy(sArgs.vArgs, vArgs) ;
+	sArgs.pArgs = NULL ;
+	sArgs.Refs	= 0 ;
+	int iRV = xPrintFormat(psXPC, fmt, &sArgs) ;
+	va_end(sArgs.vArgs) ;
 	return iRV ;
 }
 
-int snprintfx(char * pBuf, size_t szBuf, const char * format, ...) {
-	va_list vArgs ;
-	va_start(vArgs, format) ;
-	int count = vsnprintfx(pBuf, szBuf, format, vArgs) ;
-	va_end(vArgs) ;
-	return count ;
-}
+#if		(xpfSUPPORT_DEFERRED == 1) || (xpfSUPPORT_PACKED == 1)
+#if		(xpfSUPPORT_PROGRAMS == 1)
+	#define	xpfPROG_FIND(fmt)		psPrintProgFind(fmt)	// cached program if static lifetime
+#else
+	#define	xpfPROG_FIND(fmt)		NULL
+#endif
 
-int vsprintfx(char * pBuf, const char * format, va_list vArgs) {
-	return vsnprintfx(pBuf, xpfMAXLEN_MAXVAL, format, vArgs) ;
+/**
+ * xPrintPacked()
+ * \brief	format arguments packed (unaligned, native layout) in format order, not from a va_list
+ * \param	psXPC - pointer to structure containing formatting and output destination info
+ * 			psProg - compiled program for fmt, NULL to parse fmt
+ * 			fmt - format string
+ * 			pArgs - packed arguments
+ * 			Refs - 1 = pointers only (referenced data live), 0 = data copied (deferred record)
+ * \return	number of characters output
+ */
+static	int	xPrintPacked(xpc_t * psXPC, const xpp_t * psProg, const char * fmt, const void * pArgs, int Refs) {
+	xpa_t	sArgs ;
+	sArgs.pArgs = pArgs ;
+	sArgs.Refs	= Refs ;
+	if (psProg) {
+		for (int Idx = 0; Idx < psProg->Count; ++Idx) vPrintOp(psXPC, &psProg->Ops[Idx], &sArgs) ;
+		return psXPC->f.curlen ;
+	}
+	return xPrintFormat(psXPC, fmt, &sArgs) ;
 }
+#endif
 
-int sprintfx(char * pBuf, const char * format, ...) {
-	va_list	vArgs ;
-	va_start(vArgs, format) ;
-	int count = vsnprintfx(pBuf, xpfMAXLEN_MAXVAL, format, vArgs) ;
-	va_end(vArgs) ;
-	return count ;
+#if		(xpfSUPPORT_PACKED == 1)
+/**
+ * xpcprintfx_packed()
+ * \brief	format arguments packed in format order, each exactly the size the conversion fetches
+ * 			('*' & counts int, ll & 'R' 64 bit, floats double, pointers native) with referenced
+ * 			data (strings, dumps, arrays, TSZ_t) used in place. See printfx.hpp, the C++ front end.
+ * \param	psXPC - pointer to structure containing formatting and output destination info
+ * 			format - format string, static lifetime if programs are to be cached
+ * 			pArgs - packed arguments
+ * \return	number of characters output
+ */
+int	xpcprintfx_packed(xpc_t * psXPC, const char * format, const void * pArgs) {
+	return xPrintPacked(psXPC, xpfPROG_FIND(format), format, pArgs, 1) ;
 }
+#endif
 
-// ################################### Destination = STDOUT ########################################
+#if		(xpfSUPPORT_PROGRAMS == 1)
+/* ################################ Precompiled format programs ####################################
+ * A format string is compiled ONCE into a list of instructions, literal spans and conversion
+ * templates with pre-decoded flags & limits. Executing the program skips all format parsing.
+ * Compiled programs are cached in a table keyed on the format pointer, hence ONLY formats with
+ * static lifetime (string literals) should use the cached functions. A format takes the first free
+ * slot of xpfPROG_CACHE_PROBE (linear probing) from its hash. Slots are never evicted, since other
+ * tasks may be executing the program lock free, hence a format finding all its slots occupied uses
+ * the normal parser, counted as a miss.
+ */
 
-static SemaphoreHandle_t	printfxMux = NULL ;
+DUMB_STATIC_ASSERT(xpfPROG_CACHE_PROBE <= xpfPROG_CACHE_SIZE) ;
 
-void printfx_lock(void) { xRtosSemaphoreTake(&printfxMux, portMAX_DELAY) ; }
+static	xpp_t				sPrintProgCache[xpfPROG_CACHE_SIZE] ;
+static	SemaphoreHandle_t	printfxProgMux = NULL ;
+static	xpcs_t				sPrintProgStats = { .Size = xpfPROG_CACHE_SIZE } ;
 
-void printfx_unlock(void) { xRtosSemaphoreGive(&printfxMux) ; }
+/**
+ * pcPrintCompileOp() - parse the next instruction, a literal span or a conversion template
+ * \param	psOp - pointer to the instruction to be filled in
+ * 			fmt - pointer into the format string, NOT at the terminating NUL
+ * \return	pointer to the format following the instruction, an empty literal (Len 0) if a '%' ends it
+ */
+static	const char * pcPrintCompileOp(xpo_t * psOp, const char * fmt) {
+	if (*fmt == '%') {
+		fmt = pcPrintParseSpec(psOp, fmt + 1) ;
+		return (*fmt != 0) ? fmt + 1 : fmt ;
+	}
+	psOp->cFmt	= 0 ;
+	psOp->pcLit	= fmt ;
+	fmt = pcPrintNextSpec(fmt + 1) ;
+	psOp->Len	= (fmt - psOp->pcLit) > UINT16_MAX ? UINT16_MAX : fmt - psOp->pcLit ;
+	return psOp->pcLit + psOp->Len ;
+}
 
-int	 xPrintStdOut(xpc_t * psXPC, int cChr) {
-#ifdef	ESP_PLATFORM
+/**
+ * xPrintCompile()
+ * \brief	compile a format string into a program of literal spans and conversion templates
+ * \param	psProg - pointer to program structure to be filled in
+ * 			fmt - pointer to the format string, MUST remain valid while the program is in use
+ * \return	number of instructions in the program or erFAILURE if too many required
+ */
+int	xPrintCompile(xpp_t * psProg, const char * fmt) {
+	psProg->Count	= 0 ;
+	while (*fmt != 0) {
+		if (psProg->Count == xpfPROG_MAX_OPS) return erFAILURE ;
+		xpo_t * psOp = &psProg->Ops[psProg->Count] ;
+		fmt = pcPrintCompileOp(psOp, fmt) ;
+		if (psOp->cFmt == 0 && psOp->Len == 0) break ;	// '%' ending the format
+		if (psOp->cFmt == 0 && psProg->Count) {			// literal, merge with adjacent literal ?
+			xpo_t * psPrv = psOp - 1 ;
+			if (psPrv->cFmt == 0 &&
+				(psPrv->pcLit + psPrv->Len) == psOp->pcLit &&
+				(psPrv->Len + psOp->Len) <= UINT16_MAX) {
+				psPrv->Len += psOp->Len ;
+				continue ;
+			}
+		}
+		++psProg->Count ;
+	}
+	return psProg->Count ;
+}
+
+/**
+ * psPrintProgProbe() - find the slot holding fmt, or the first free slot, in the probe sequence
+ * \return	pointer to the slot or NULL if all probed slots hold other formats
+ * \note	slots are filled in probe order & never freed, hence fmt if cached precedes any free slot
+ */
+static	xpp_t * psPrintProgProbe(const char * fmt) {
+	uint32_t Idx = (uint32_t) ((uint32_t) (uintptr_t) fmt * 2654435761U) >> (32 - xpfPROG_CACHE_BITS) ;
+	for (int Probe = 0; Probe < xpfPROG_CACHE_PROBE; ++Probe) {
+		xpp_t * psProg = &sPrintProgCache[(Idx + Probe) & (xpfPROG_CACHE_SIZE - 1)] ;
+		const char * pcKey = __atomic_load_n(&psProg->pcFmt, __ATOMIC_ACQUIRE) ;
+		if (pcKey == fmt || pcKey == NULL) return psProg ;
+	}
+	return NULL ;
+}
+
+/**
+ * psPrintProgFind()
+ * \brief	find (or compile & cache) the program for a format string with static lifetime
+ * \param	fmt - pointer to the format string
+ * \return	pointer to the cached program or NULL if no free slot or format too complex
+ * \note	a format too complex to compile keeps the slot, marked xpfPROG_NONE, so is never retried
+ */
+const xpp_t * psPrintProgFind(const char * fmt) {
+	xpp_t * psProg = psPrintProgProbe(fmt) ;
+	if (psProg && __atomic_load_n(&psProg->pcFmt, __ATOMIC_ACQUIRE) != fmt) {	// free slot, claim it
+		xRtosSemaphoreTake(&printfxProgMux, portMAX_DELAY) ;
+		psProg = psPrintProgProbe(fmt) ;				// again, another task may have added slots
+		if (psProg && psProg->pcFmt == NULL) {
+			if (xPrintCompile(psProg, fmt) == erFAILURE) psProg->Count = xpfPROG_NONE ;	// parse, don't retry
+			__atomic_store_n(&psProg->pcFmt, fmt, __ATOMIC_RELEASE) ;	// publish only once complete
+			__atomic_fetch_add(&sPrintProgStats.Slots, 1, __ATOMIC_RELAXED) ;
+		}
+		xRtosSemaphoreGive(&printfxProgMux) ;
+	}
+	if (psProg == NULL) {
+		__atomic_fetch_add(&sPrintProgStats.Misses, 1, __ATOMIC_RELAXED) ;
+		return NULL ;
+	}
+	if (psProg->Count == xpfPROG_NONE) return NULL ;	// too complex, parsed
+	__atomic_fetch_add(&sPrintProgStats.Hits, 1, __ATOMIC_RELAXED) ;
+	return psProg ;
+}
+
+/**
+ * vPrintProgStats() - snapshot of the program cache counters
+ */
+void	vPrintProgStats(xpcs_t * psStats) {
+	psStats->Hits		= __atomic_load_n(&sPrintProgStats.Hits, __ATOMIC_RELAXED) ;
+	psStats->Misses		= __atomic_load_n(&sPrintProgStats.Misses, __ATOMIC_RELAXED) ;
+	psStats->Slots		= __atomic_load_n(&sPrintProgStats.Slots, __ATOMIC_RELAXED) ;
+	psStats->Size		= sPrintProgStats.Size ;
+}
+
+/**
+ * xpcprintfx_prog()
+ * \brief	execute a compiled format program, no parsing performed
+ * \param	psXPC - pointer to structure containing formatting and output destination info
+ * 			psProg - pointer to compiled program
+ * 			vArgs - variable number of arguments
+ * \return	number of characters output
+ */
+int	xpcprintfx_prog(xpc_t * psXPC, const xpp_t * psProg, va_list vArgs) {
+	xpa_t	sArgs ;
+	va_copy(sArgs.vArgs, vArgs) ;
+	sArgs.pArgs = NULL ;
+	sArgs.Refs	= 0 ;
+	for (int Idx = 0; Idx < psProg->Count; ++Idx) vPrintOp(psXPC, &psProg->Ops[Idx], &sArgs) ;
+	va_end(sArgs.vArgs) ;
+	return psXPC->f.curlen ;
+}
+
+/**
+ * xpcprintfx_cached()
+ * \brief	execute the cached program for a static format, falling back to the parser if not cacheable
+ * \param	psXPC - pointer to structure containing formatting and output destination info
+ * 			fmt - pointer to the format string, MUST have static lifetime
+ * 			vArgs - variable number of arguments
+ * \return	number of characters output
+ */
+int	xpcprintfx_cached(xpc_t * psXPC, const char * fmt, va_list vArgs) {
+	const xpp_t * psProg = psPrintProgFind(fmt) ;
+	return psProg ? xpcprintfx_prog(psXPC, psProg, vArgs) : xpcprintfx(psXPC, fmt, vArgs) ;
+}
+#endif
+
+#if		(xpfSUPPORT_BATCH == 1)
+/* ################################### Batch output of records #####################################
+ * The format is compiled ONCE per call, on the stack hence any lifetime, and the program executed
+ * for every record with values loaded from the record fields instead of fetched from arguments.
+ * Formats needing more than xpfPROG_MAX_OPS instructions (wide rows) are parsed for every record.
+ * Sinks without a limit (maxlen == 0) have curlen restarted per record, so the total output is not
+ * restricted to xpfMAXLEN_MAXVAL. Fields need not be aligned, loads are little endian.
+ */
+
+static	const uint8_t sPrintFieldSize[] = { 1, 1, 2, 2, 4, 4, 8, 8, 4, 8 } ;
+
+typedef	struct xpbw_t {									// batch format walk
+	const xpp_t *	psProg ;							// compiled program, NULL if too many ops
+	const char *	pcFmt ;								// next instruction if parsed
+	int				Idx ;								// next instruction if compiled
+	xpo_t			sOp ;								// parsed instruction
+} xpbw_t ;
+
+/**
+ * psPrintBatchNext() - next instruction, from the program or parsed if the format is too complex
+ * \return	pointer to the instruction or NULL at the end of the format
+ */
+static	const xpo_t * psPrintBatchNext(xpbw_t * psW) {
+	if (psW->psProg)
+		return (psW->Idx < psW->psProg->Count) ? &psW->psProg->Ops[psW->Idx++] : NULL ;
+	if (*psW->pcFmt == 0) return NULL ;
+	psW->pcFmt = pcPrintCompileOp(&psW->sOp, psW->pcFmt) ;
+	return (psW->sOp.cFmt == 0 && psW->sOp.Len == 0) ? NULL : &psW->sOp ;	// '%' ending the format
+}
+
+/**
+ * xPrintBatchCheck()
+ * \brief	verify that the conversions of a format match the field descriptors of a batch
+ * \param	sW - format walk at the start, walked as a copy
+ * 			psBatch - pointer to batch with field descriptors
+ * \return	erSUCCESS or erFAILURE if a conversion, field type or the number of fields is invalid
+ */
+static	int	xPrintBatchCheck(xpbw_t sW, const xpb_t * psBatch) {
+	int		Field = 0 ;
+	const xpo_t * psOp ;
+	while ((psOp = psPrintBatchNext(&sW)) != NULL) {
+		if (psOp->cFmt == 0) continue ;
+		if (Field == psBatch->Fields) return erFAILURE ;
+		if (psOp->Args & (xpoARG_WIDTH | xpoARG_PRECIS | xpoARG_COUNT)) return erFAILURE ;
+		int Type = psBatch->psField[Field++].Type ;
+		if (psOp->Args & xpoARG_ARRAY) {				// elements inline in the record
+			if (Type != xpfFIELD_REF || (psOp->Args & xpoARR_INVALID)) return erFAILURE ;
+			continue ;
+		}
+		switch (psOp->cFmt) {
+	#if		(xpfSUPPORT_POINTER == 1)
+		case CHR_p:
+	#endif
+		case CHR_s:
+			if (Type != xpfFIELD_PTR && Type != xpfFIELD_REF) return erFAILURE ;
+			break ;
+	#if		(xpfSUPPORT_IEEE754 == 1)
+		case CHR_e:
+		case CHR_f:
+		case CHR_a:
+		case CHR_g:
+			if (Type > xpfFIELD_F64) return erFAILURE ;	// integer fields converted
+			break ;
+	#endif
+	#if		(xpfSUPPORT_BINARY == 1)
+		case CHR_J:
+	#endif
+	#if		(xpfSUPPORT_IP_ADDR == 1)
+		case CHR_I:
+	#endif
+		case CHR_c:
+		case CHR_d:
+		case CHR_i:
+		case CHR_o:
+		case CHR_x:
+		case CHR_u:
+			if (Type >= xpfFIELD_F32) return erFAILURE ;
+			break ;
+		default:
+			return erFAILURE ;
+		}
+	}
+	return (Field == psBatch->Fields) ? erSUCCESS : erFAILURE ;
+}
+
+/**
+ * vPrintField()
+ * \brief	load a record field as the conversion requires & output it, flags & limits set up
+ * \param	psXPC - pointer to structure containing formatting and output destination info
+ * 			psOp - pointer to conversion instruction
+ * 			pField - pointer to the field in the record
+ * 			Type - field type, xpfFIELD_???
+ * \return	none
+ */
+static	void vPrintField(xpc_t * psXPC, const xpo_t * psOp, const uint8_t * pField, int Type) {
+	x64_t	x64Val ;
+#if		(xpfSUPPORT_ARRAYS == 1)
+	if (psOp->Args & xpoARG_ARRAY) {
+		vPrintArray(psXPC, psOp, psOp->Count, pField) ;
+		return ;
+	}
+#endif
+	if (Type >= xpfFIELD_PTR) {
+		const char * pcStr = (const char *) pField ;
+		if (Type == xpfFIELD_PTR) memcpy(&pcStr, pField, sizeof(pcStr)) ;
+	#if		(xpfSUPPORT_POINTER == 1)
+		if (psOp->cFmt == CHR_p) {
+			vPrintPointer(psXPC, (void *) pcStr) ;
+			return ;
+		}
+	#endif
+		pcStr = halCONFIG_inMEM(pcStr) ? pcStr : pcStr == NULL ? STRING_NULL : STRING_OOR ;
+		psXPC->f.stable = 1 ;							// valid until the call returns
+		vPrintString(psXPC, (char *) pcStr) ;
+		psXPC->f.stable = 0 ;
+		return ;
+	}
+	int		Size = sPrintFieldSize[Type] ;
+	x64Val.u64 = 0ULL ;									// zero extended to 64 bits
+	memcpy(&x64Val.u64, pField, Size) ;
+	if (Type == xpfFIELD_F32) {
+		float F32 ;
+		memcpy(&F32, pField, sizeof(F32)) ;
+		x64Val.f64 = F32 ;
+	}
+	int		Signed = (Type < xpfFIELD_F32) && (Type & 1) == 0 ;	// I8, I16, I32 & I64
+	if (Signed && Size < 8 && (x64Val.u64 >> (Size * 8 - 1)))
+		x64Val.u64 |= ~0ULL << (Size * 8) ;
+	switch (psOp->cFmt) {
+	case CHR_c:
+		vPrintChar(psXPC, x64Val.u64) ;
+		break ;
+
+#if		(xpfSUPPORT_IP_ADDR == 1)
+	case CHR_I:
+		vPrintIpAddress(psXPC, x64Val.u64) ;
+		break ;
+#endif
+
+	case CHR_o:											// unsigned, value as stored in the field
+	case CHR_x:
+	case CHR_u:
+	case CHR_J:
+		if (Signed && Size < 8) x64Val.u64 &= ~0ULL >> (64 - Size * 8) ;
+		vPrintValue(psXPC, psOp->cFmt, x64Val) ;
+		break ;
+
+	case CHR_e:
+	case CHR_f:
+	case CHR_a:
+	case CHR_g:
+		if (Type < xpfFIELD_F32) x64Val.f64 = Signed ? (double) x64Val.i64 : (double) x64Val.u64 ;
+		/* FALLTHRU */ /* no break */
+	default:
+		vPrintValue(psXPC, psOp->cFmt, x64Val) ;
+		break ;
+	}
+}
+
+/**
+ * xpcprintfx_batch()
+ * \brief	format records [Next, Count) of an array of structures, format compiled once (if not too
+ * 			complex, else parsed per record), no arguments
+ * \param	psXPC - pointer to structure containing formatting and output destination info, if maxlen
+ * 					is non zero only complete records (leaving space for a terminator) are output
+ * 			fmt - pointer to the format string, applied to every record
+ * 			psBatch - pointer to batch, Next updated to the first record not output
+ * \return	number of characters output or erFAILURE if format & field descriptors do not match
+ */
+int	xpcprintfx_batch(xpc_t * psXPC, const char * fmt, xpb_t * psBatch) {
+	xpp_t	sProg ;
+	xpbw_t	sW = { .psProg = &sProg, .pcFmt = fmt, .Idx = 0 } ;
+	if (xPrintCompile(&sProg, fmt) == erFAILURE) sW.psProg = NULL ;	// too many ops, parse per record
+	if (xPrintBatchCheck(sW, psBatch) == erFAILURE) return erFAILURE ;
+	int		Total = 0 ;
+	const uint8_t * pRec = (const uint8_t *) psBatch->pvBase + (size_t) psBatch->Next * psBatch->Stride ;
+	for (; psBatch->Next < psBatch->Count; ++psBatch->Next, pRec += psBatch->Stride) {
+		int		Mark = psXPC->f.curlen ;
+		const xpbf_t * psField = psBatch->psField ;
+		const xpo_t * psOp ;
+		sW.pcFmt	= fmt ;
+		sW.Idx		= 0 ;
+		while ((psOp = psPrintBatchNext(&sW)) != NULL) {
+			if (psOp->cFmt == 0) {
+				vPrintSpanRef(psXPC, psOp->pcLit, psOp->Len) ;
+				continue ;
+			}
+			psXPC->f.limits	= psOp->limits ;
+			psXPC->f.flags	= psOp->flags ;
+			vPrintField(psXPC, psOp, pRec + psField->Offset, psField->Type) ;
+			++psField ;
+		}
+		if (psXPC->f.maxlen == 0) {						// no limit, restart count per record
+			Total += psXPC->f.curlen ;
+			psXPC->f.curlen = 0 ;
+		} else if (psXPC->f.curlen >= psXPC->f.maxlen) {	// record (possibly) clipped, exclude it
+			psXPC->f.curlen = Mark ;
+			break ;
+		}
+	}
+	return Total + psXPC->f.curlen ;
+}
+#endif
+
+/**
+ * xPrintHandlerSpan() - adapter presenting a legacy single character handler as a span sink
+ * \param	psXPC - pointer to control structure, handler member must be valid
+ * 			pStr - pointer to characters to be output
+ * 			szLen - number of characters to output
+ * \return	number of characters accepted by the handler
+ */
+int	xPrintHandlerSpan(xpc_t * psXPC, const char * pStr, size_t szLen) {
+	int	Count = 0 ;
+	while (szLen--) {
+		char cChr = *pStr++ ;
+		if (psXPC->handler(psXPC, cChr) == cChr) ++Count ;
+	}
+	return Count ;
+}
+
+int	xprintfx_span(int (Wrtr)(xpc_t *, const char *, size_t), void * pVoid, size_t szBuf, const char * fmt, va_list vArgs) {
+	xpc_t	sXPC ;
+	sXPC.handler	= NULL ;
+	sXPC.writer		= Wrtr ;
+	sXPC.pVoid		= pVoid ;
+	sXPC.f.maxlen	= (szBuf > xpfMAXLEN_MAXVAL) ? xpfMAXLEN_MAXVAL : szBuf ;
+	sXPC.f.curlen	= 0 ;
+	return xpcprintfx(&sXPC, fmt, vArgs) ;
+}
+
+int	xprintfx(int (Hdlr)(xpc_t *, int), void * pVoid, size_t szBuf, const char * fmt, va_list vArgs) {
+	xpc_t	sXPC ;
+	sXPC.handler	= Hdlr ;
+	sXPC.writer		= xPrintHandlerSpan ;
+	sXPC.pVoid		= pVoid ;
+	sXPC.f.maxlen	= (szBuf > xpfMAXLEN_MAXVAL) ? xpfMAXLEN_MAXVAL : szBuf ;
+	sXPC.f.curlen	= 0 ;
+	return xpcprintfx(&sXPC, fmt, vArgs) ;
+}
+
+// ##################################### Destination = STRING ######################################
+
+int	xPrintToString(xpc_t * psXPC, int cChr) {
+	if (psXPC->pStr) *psXPC->pStr++ = cChr;
+	return cChr ;
+}
+
+int	xPrintToStringSpan(xpc_t * psXPC, const char * pStr, size_t szLen) {
+	if (psXPC->pStr) {
+		memcpy(psXPC->pStr, pStr, szLen) ;
+		psXPC->pStr += szLen ;
+	}
+	return szLen ;
+}
+
+int vsnprintfx(char * pBuf, size_t szBuf, const char * format, va_list vArgs) {
+	if (szBuf == 1) {									// no space ?
+		if (pBuf) *pBuf = 0 ;							// yes, terminate
+		return 0 ; 										// & return
+	}
+	int iRV = xprintfx_span(xPrintToStringSpan, pBuf, szBuf, format, vArgs) ;
+	if (pBuf) {											// Buffer specified ?
+		if (iRV == (int) szBuf) --iRV ;						// make space for terminator
+		pBuf[iRV] = 0 ;									// terminate
+	}
+	return iRV ;
+}
+
+int snprintfx(char * pBuf, size_t szBuf, const char * format, ...) {
+	va_list vArgs ;
+	va_start(vArgs, format) ;
+	int count = vsnprintfx(pBuf, szBuf, format, vArgs) ;
+	va_end(vArgs) ;
+	return count ;
+}
+
+/*
+ * vsnprintfx_cached() - as for vsnprintfx() but using the cached program for a format with static lifetime
+ */
+int vsnprintfx_cached(char * pBuf, size_t szBuf, const char * format, va_list vArgs) {
+	if (szBuf == 1) {
+		if (pBuf) *pBuf = 0 ;
+		return 0 ;
+	}
+	xpc_t	sXPC ;
+	sXPC.handler	= NULL ;
+	sXPC.writer		= xPrintToStringSpan ;
+	sXPC.pStr		= pBuf ;
+	sXPC.f.maxlen	= (szBuf > xpfMAXLEN_MAXVAL) ? xpfMAXLEN_MAXVAL : szBuf ;
+	sXPC.f.curlen	= 0 ;
+#if		(xpfSUPPORT_PROGRAMS == 1)
+	int iRV = xpcprintfx_cached(&sXPC, format, vArgs) ;
+#else
+	int iRV = xpcprintfx(&sXPC, format, vArgs) ;
+#endif
+	if (pBuf) {
+		if (iRV == (int) szBuf) --iRV ;
+		pBuf[iRV] = 0 ;
+	}
+	return iRV ;
+}
+
+int snprintfx_cached(char * pBuf, size_t szBuf, const char * format, ...) {
+	va_list vArgs ;
+	va_start(vArgs, format) ;
+	int count = vsnprintfx_cached(pBuf, szBuf, format, vArgs) ;
+	va_end(vArgs) ;
+	return count ;
+}
+
+#if		(xpfSUPPORT_BATCH == 1)
+/*
+ * snprintfx_batch() - records of a batch to a buffer, complete records only, see xpcprintfx_batch()
+ */
+int snprintfx_batch(char * pBuf, size_t szBuf, const char * format, xpb_t * psBatch) {
+	if (szBuf == 1) {
+		if (pBuf) *pBuf = 0 ;
+		return 0 ;
+	}
+	xpc_t	sXPC ;
+	sXPC.handler	= NULL ;
+	sXPC.writer		= xPrintToStringSpan ;
+	sXPC.pStr		= pBuf ;
+	sXPC.f.maxlen	= (szBuf > xpfMAXLEN_MAXVAL) ? xpfMAXLEN_MAXVAL : szBuf ;
+	sXPC.f.curlen	= 0 ;
+	int iRV = xpcprintfx_batch(&sXPC, format, psBatch) ;
+	if (pBuf && iRV >= 0) pBuf[iRV] = 0 ;
+	return iRV ;
+}
+#endif
+
+#if		(xpfSUPPORT_PACKED == 1)
+/*
+ * snprintfx_packed() - as for snprintfx() with packed arguments, see xpcprintfx_packed()
+ */
+int snprintfx_packed(char * pBuf, size_t szBuf, const char * format, const void * pArgs) {
+	if (szBuf == 1) {
+		if (pBuf) *pBuf = 0 ;
+		return 0 ;
+	}
+	xpc_t	sXPC ;
+	sXPC.handler	= NULL ;
+	sXPC.writer		= xPrintToStringSpan ;
+	sXPC.pStr		= pBuf ;
+	sXPC.f.maxlen	= (szBuf > xpfMAXLEN_MAXVAL) ? xpfMAXLEN_MAXVAL : szBuf ;
+	sXPC.f.curlen	= 0 ;
+	int iRV = xpcprintfx_packed(&sXPC, format, pArgs) ;
+	if (pBuf) {
+		if (iRV == (int) szBuf) --iRV ;
+		pBuf[iRV] = 0 ;
+	}
+	return iRV ;
+}
+#endif
+
+int vsprintfx(char * pBuf, const char * format, va_list vArgs) {
+	return vsnprintfx(pBuf, xpfMAXLEN_MAXVAL, format, vArgs) ;
+}
+
+int sprintfx(char * pBuf, const char * format, ...) {
+	va_list	vArgs ;
+	va_start(vArgs, format) ;
+	int count = vsnprintfx(pBuf, xpfMAXLEN_MAXVAL, format, vArgs) ;
+	va_end(vArgs) ;
+	return count ;
+}
+
+// ################################### Destination = STDOUT ########################################
+
+static SemaphoreHandle_t	printfxMux = NULL ;
+
+void printfx_lock(void) { xRtosSemaphoreTake(&printfxMux, portMAX_DELAY) ; }
+
+void printfx_unlock(void) { xRtosSemaphoreGive(&printfxMux) ; }
+
+int	 xPrintStdOut(xpc_t * psXPC, int cChr) {
+#ifdef	ESP_PLATFORM
 	return putcx(cChr, configSTDIO_UART_CHAN) ;
 #else
 	return putchar(cChr) ;
 #endif
 }
 
+#if		(xpfSUPPORT_ASYNC == 1)
+/* ################################ Asynchronous STDOUT pipeline ###################################
+ * Once started, stdout output is formatted into a buffer on the calling task's stack and the
+ * finished record copied into a lock free multi producer ring (bounded MPMC queue, a sequence
+ * number per slot). A dedicated task drains the ring to stdout, callers never wait for the UART.
+ * Each call is output as a whole, never split: output longer than xpfASYNC_REC_SIZE (eg hexdump
+ * rows) switches the call to synchronous, under printfx_lock() after draining the ring so order
+ * is kept. The writer task takes printfx_lock() per record hence a task holding the lock (which
+ * the writer would wait for) also outputs synchronously, never queues & never waits for space.
+ * With xpfASYNC_BLOCK a producer finding the ring full waits on PrintAsyncSpace, given (latched,
+ * binary) after every take, so it retries as soon as a slot is freed rather than a tick later.
+ * The *_nolock() functions remain synchronous. */
+
+typedef	struct xpar_t {									// ring record slot
+	uint32_t	Seq ;									// slot sequence, owner & state
+	uint16_t	Len ;
+	char		Buf[xpfASYNC_REC_SIZE] ;
+} xpar_t ;
+
+typedef	struct xpab_t {									// per call staging buffer
+	uint16_t	Used ;
+	uint8_t		Direct ;								// output synchronous, straight to stdout
+	uint8_t		Locked ;								// printfx_lock() taken by this call
+	char		Buf[xpfASYNC_REC_SIZE] ;
+} xpab_t ;
+
+DUMB_STATIC_ASSERT((xpfASYNC_RECORDS & (xpfASYNC_RECORDS - 1)) == 0) ;
+
+static	xpar_t			sPrintAsyncRing[xpfASYNC_RECORDS] ;
+static	uint32_t		PrintAsyncHead, PrintAsyncTail ;
+static	TaskHandle_t	PrintAsyncTask = NULL ;
+static	SemaphoreHandle_t	PrintAsyncSpace = NULL ;	// slot freed, xpfASYNC_BLOCK only
+static	uint8_t			PrintAsyncPolicy ;
+static	xpas_t			sPrintAsyncStats ;
+
+/**
+ * xPrintAsyncTake() - remove oldest record from the ring
+ * \param	pBuf - buffer to receive record, NULL to discard
+ * \return	length of record or -1 if ring empty
+ */
+static	int	xPrintAsyncTake(char * pBuf) {
+	uint32_t Pos = __atomic_load_n(&PrintAsyncTail, __ATOMIC_RELAXED) ;
+	while (1) {
+		xpar_t * psR = &sPrintAsyncRing[Pos & (xpfASYNC_RECORDS - 1)] ;
+		int32_t	Dif = (int32_t) (__atomic_load_n(&psR->Seq, __ATOMIC_ACQUIRE) - (Pos + 1)) ;
+		if (Dif < 0)
+			return -1 ;									// empty (or oldest not yet published)
+		if (Dif == 0 && __atomic_compare_exchange_n(&PrintAsyncTail, &Pos, Pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+			int Len = psR->Len ;
+			if (pBuf) memcpy(pBuf, psR->Buf, Len) ;
+			__atomic_store_n(&psR->Seq, Pos + xpfASYNC_RECORDS, __ATOMIC_RELEASE) ;	// free for producers
+			if (PrintAsyncSpace) xSemaphoreGive(PrintAsyncSpace) ;	// wake a blocked producer
+			return Len ;
+		}
+		if (Dif > 0) Pos = __atomic_load_n(&PrintAsyncTail, __ATOMIC_RELAXED) ;	// CAS failure reloads Pos
+	}
+}
+
+/**
+ * vPrintAsyncPut() - copy a record into the ring, applying the overflow policy if full
+ */
+static	void vPrintAsyncPut(const char * pStr, int Len) {
+	uint32_t Pos = __atomic_load_n(&PrintAsyncHead, __ATOMIC_RELAXED) ;
+	while (1) {
+		xpar_t * psR = &sPrintAsyncRing[Pos & (xpfASYNC_RECORDS - 1)] ;
+		int32_t	Dif = (int32_t) (__atomic_load_n(&psR->Seq, __ATOMIC_ACQUIRE) - Pos) ;
+		if (Dif == 0) {
+			if (__atomic_compare_exchange_n(&PrintAsyncHead, &Pos, Pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+				memcpy(psR->Buf, pStr, Len) ;
+				psR->Len = Len ;
+				__atomic_store_n(&psR->Seq, Pos + 1, __ATOMIC_RELEASE) ;		// publish
+				__atomic_fetch_add(&sPrintAsyncStats.Records, 1, __ATOMIC_RELAXED) ;
+				xTaskNotifyGive(PrintAsyncTask) ;
+				return ;
+			}
+			continue ;									// CAS failure reloaded Pos
+		}
+		if (Dif < 0) {									// full
+			if (PrintAsyncPolicy == xpfASYNC_DROP) {
+				__atomic_fetch_add(&sPrintAsyncStats.Dropped, 1, __ATOMIC_RELAXED) ;
+				return ;
+			}
+			if (PrintAsyncPolicy == xpfASYNC_OVERWRITE) {
+				if (xPrintAsyncTake(NULL) >= 0)
+					__atomic_fetch_add(&sPrintAsyncStats.Overwritten, 1, __ATOMIC_RELAXED) ;
+			} else {									// xpfASYNC_BLOCK
+				__atomic_fetch_add(&sPrintAsyncStats.Blocked, 1, __ATOMIC_RELAXED) ;
+				xTaskNotifyGive(PrintAsyncTask) ;
+				xSemaphoreTake(PrintAsyncSpace, portMAX_DELAY) ;	// until the next take
+			}
+		}
+		Pos = __atomic_load_n(&PrintAsyncHead, __ATOMIC_RELAXED) ;
+	}
+}
+
+/**
+ * vPrintStdOutSpan() - write a span to stdout, as xPrintStdOut() but a single call per span
+ */
+static	void vPrintStdOutSpan(const char * pStr, size_t szLen) {
+#ifdef	ESP_PLATFORM
+	while (szLen--) putcx(*pStr++, configSTDIO_UART_CHAN) ;	// x_stdio has no block write
+#else
+	fwrite(pStr, 1, szLen, stdout) ;
+#endif
+}
+
+/**
+ * xPrintAsyncHolder() - check if the calling task holds printfx_lock()
+ */
+static	int	xPrintAsyncHolder(void) {
+	return printfxMux && xSemaphoreGetMutexHolder(printfxMux) == xTaskGetCurrentTaskHandle() ;
+}
+
+/**
+ * vPrintAsyncDrain() - output all queued records synchronously, MUST hold printfx_lock()
+ */
+static	void vPrintAsyncDrain(void) {
+	char	Buffer[xpfASYNC_REC_SIZE] ;
+	int		Len ;
+	while ((Len = xPrintAsyncTake(Buffer)) >= 0) vPrintStdOutSpan(Buffer, Len) ;
+}
+
+/**
+ * vPrintAsyncDirect() - switch the call to synchronous output, ring drained first to keep order
+ */
+static	void vPrintAsyncDirect(xpab_t * psB) {
+	if (xPrintAsyncHolder() == 0) {
+		printfx_lock() ;
+		psB->Locked = 1 ;
+	}
+	vPrintAsyncDrain() ;
+	vPrintStdOutSpan(psB->Buf, psB->Used) ;
+	psB->Used	= 0 ;
+	psB->Direct	= 1 ;
+}
+
+static	void vPrintAsyncBegin(xpab_t * psB) {
+	psB->Used	= 0 ;
+	psB->Direct	= 0 ;
+	psB->Locked	= 0 ;
+	if (xPrintAsyncHolder()) vPrintAsyncDirect(psB) ;	// writer would wait for our lock
+}
+
+static	void vPrintAsyncEnd(xpab_t * psB) {
+	if (psB->Direct) {
+		if (psB->Locked) printfx_unlock() ;
+	} else if (psB->Used) {
+		vPrintAsyncPut(psB->Buf, psB->Used) ;
+	}
+}
+
+int	xPrintToAsync(xpc_t * psXPC, const char * pStr, size_t szLen) {
+	xpab_t * psB = psXPC->pVoid ;
+	if (psB->Direct == 0 && (psB->Used + szLen) > sizeof(psB->Buf))
+		vPrintAsyncDirect(psB) ;						// too long for a record
+	if (psB->Direct) {
+		vPrintStdOutSpan(pStr, szLen) ;
+	} else {
+		memcpy(&psB->Buf[psB->Used], pStr, szLen) ;
+		psB->Used += szLen ;
+	}
+	return szLen ;
+}
+
+static	int	xPrintAsyncRun(size_t szLen, const char * format, va_list vArgs, int Cached) {
+	xpab_t	sB ;
+	xpc_t	sXPC ;
+	vPrintAsyncBegin(&sB) ;
+	sXPC.handler	= NULL ;
+	sXPC.writer		= xPrintToAsync ;
+	sXPC.pVoid		= &sB ;
+	sXPC.f.maxlen	= (szLen > xpfMAXLEN_MAXVAL) ? xpfMAXLEN_MAXVAL : szLen ;
+	sXPC.f.curlen	= 0 ;
+#if		(xpfSUPPORT_PROGRAMS == 1)
+	int iRV = Cached ? xpcprintfx_cached(&sXPC, format, vArgs) : xpcprintfx(&sXPC, format, vArgs) ;
+#else
+	int iRV = xpcprintfx(&sXPC, format, vArgs) ;
+#endif
+	vPrintAsyncEnd(&sB) ;
+	return iRV ;
+}
+
+static	void vPrintAsyncTask(void * pvPara) {
+	(void) pvPara ;
+	char	Buffer[xpfASYNC_REC_SIZE] ;
+	while (1) {
+		printfx_lock() ;								// take AND write under the lock, so
+		int Len = xPrintAsyncTake(Buffer) ;				// lock holders draining the ring never
+		if (Len >= 0) vPrintStdOutSpan(Buffer, Len) ;	// overtake a record already taken
+		printfx_unlock() ;
+		if (Len < 0) ulTaskNotifyTake(pdTRUE, portMAX_DELAY) ;
+	}
+}
+
+/**
+ * xPrintAsyncStart() - switch stdout output to the asynchronous pipeline
+ * \param	Policy - xpfASYNC_BLOCK, xpfASYNC_DROP or xpfASYNC_OVERWRITE when the ring is full
+ * \return	erSUCCESS or erFAILURE if already started or writer task could not be created
+ */
+int	xPrintAsyncStart(int Policy) {
+	IF_myASSERT(debugPARAM, INRANGE(xpfASYNC_BLOCK, Policy, xpfASYNC_OVERWRITE, int)) ;
+	if (PrintAsyncTask) return erFAILURE ;
+	for (int Idx = 0; Idx < xpfASYNC_RECORDS; ++Idx) sPrintAsyncRing[Idx].Seq = Idx ;
+	PrintAsyncHead = PrintAsyncTail = 0 ;
+	PrintAsyncPolicy = Policy ;
+	if (Policy == xpfASYNC_BLOCK && PrintAsyncSpace == NULL && (PrintAsyncSpace = xSemaphoreCreateBinary()) == NULL)
+		return erFAILURE ;
+	TaskHandle_t Task ;
+	if (xTaskCreate(vPrintAsyncTask, "printfx", xpfASYNC_STACK, NULL, xpfASYNC_PRIORITY, &Task) != pdPASS)
+		return erFAILURE ;
+	__atomic_store_n(&PrintAsyncTask, Task, __ATOMIC_RELEASE) ;	// producers switch over
+	return erSUCCESS ;
+}
+
+/**
+ * vPrintAsyncStats() - snapshot of the pipeline counters
+ */
+void	vPrintAsyncStats(xpas_t * psStats) {
+	psStats->Records		= __atomic_load_n(&sPrintAsyncStats.Records, __ATOMIC_RELAXED) ;
+	psStats->Dropped		= __atomic_load_n(&sPrintAsyncStats.Dropped, __ATOMIC_RELAXED) ;
+	psStats->Overwritten	= __atomic_load_n(&sPrintAsyncStats.Overwritten, __ATOMIC_RELAXED) ;
+	psStats->Blocked		= __atomic_load_n(&sPrintAsyncStats.Blocked, __ATOMIC_RELAXED) ;
+}
+#endif
+
 int vnprintfx(size_t szLen, const char * format, va_list vArgs) {
+#if		(xpfSUPPORT_ASYNC == 1)
+	if (__atomic_load_n(&PrintAsyncTask, __ATOMIC_ACQUIRE))
+		return xPrintAsyncRun(szLen, format, vArgs, 0) ;
+#endif
 	printfx_lock() ;
 	int iRV = xprintfx(xPrintStdOut, stdout, szLen, format, vArgs) ;
 	printfx_unlock() ;
@@ -1261,6 +3105,126 @@ int printfx(const char * format, ...) {
 	return iRV ;
 }
 
+/*
+ * vprintfx_cached() - print to stdout using the cached program for a format with static lifetime
+ */
+int vprintfx_cached(const char * format, va_list vArgs) {
+#if		(xpfSUPPORT_ASYNC == 1)
+	if (__atomic_load_n(&PrintAsyncTask, __ATOMIC_ACQUIRE))
+		return xPrintAsyncRun(xpfMAXLEN_MAXVAL, format, vArgs, 1) ;
+#endif
+	xpc_t	sXPC ;
+	sXPC.handler	= xPrintStdOut ;
+	sXPC.writer		= xPrintHandlerSpan ;
+	sXPC.pVoid		= stdout ;
+	sXPC.f.maxlen	= xpfMAXLEN_MAXVAL ;
+	sXPC.f.curlen	= 0 ;
+	printfx_lock() ;
+#if		(xpfSUPPORT_PROGRAMS == 1)
+	int iRV = xpcprintfx_cached(&sXPC, format, vArgs) ;
+#else
+	int iRV = xpcprintfx(&sXPC, format, vArgs) ;
+#endif
+	printfx_unlock() ;
+	return iRV ;
+}
+
+int printfx_cached(const char * format, ...) {
+	va_list vArgs ;
+	va_start(vArgs, format) ;
+	int iRV = vprintfx_cached(format, vArgs) ;
+	va_end(vArgs) ;
+	return iRV ;
+}
+
+/*
+ * printfx_span() - output already formatted, written as is (NUL included), locked or async as printfx()
+ */
+int printfx_span(const char * pStr, size_t szLen) {
+	xpc_t	sXPC ;
+	sXPC.f.maxlen	= xpfMAXLEN_MAXVAL ;
+	sXPC.f.curlen	= 0 ;
+#if		(xpfSUPPORT_ASYNC == 1)
+	if (__atomic_load_n(&PrintAsyncTask, __ATOMIC_ACQUIRE)) {
+		xpab_t	sB ;
+		vPrintAsyncBegin(&sB) ;
+		sXPC.handler	= NULL ;
+		sXPC.writer		= xPrintToAsync ;
+		sXPC.pVoid		= &sB ;
+		vPrintSpanRef(&sXPC, pStr, szLen) ;
+		vPrintAsyncEnd(&sB) ;
+		return sXPC.f.curlen ;
+	}
+#endif
+	sXPC.handler	= xPrintStdOut ;
+	sXPC.writer		= xPrintHandlerSpan ;
+	sXPC.pVoid		= stdout ;
+	printfx_lock() ;
+	vPrintSpanRef(&sXPC, pStr, szLen) ;
+	printfx_unlock() ;
+	return sXPC.f.curlen ;
+}
+
+#if		(xpfSUPPORT_BATCH == 1)
+/*
+ * printfx_batch() - records of a batch to stdout, ONE lock (or async pipeline) for all records
+ */
+int printfx_batch(const char * format, xpb_t * psBatch) {
+	xpc_t	sXPC ;
+	sXPC.f.maxlen	= 0 ;								// no limit, see xpcprintfx_batch()
+	sXPC.f.curlen	= 0 ;
+#if		(xpfSUPPORT_ASYNC == 1)
+	if (__atomic_load_n(&PrintAsyncTask, __ATOMIC_ACQUIRE)) {
+		xpab_t	sB ;
+		vPrintAsyncBegin(&sB) ;
+		sXPC.handler	= NULL ;
+		sXPC.writer		= xPrintToAsync ;
+		sXPC.pVoid		= &sB ;
+		int iRV = xpcprintfx_batch(&sXPC, format, psBatch) ;
+		vPrintAsyncEnd(&sB) ;
+		return iRV ;
+	}
+#endif
+	sXPC.handler	= xPrintStdOut ;
+	sXPC.writer		= xPrintHandlerSpan ;
+	sXPC.pVoid		= stdout ;
+	printfx_lock() ;
+	int iRV = xpcprintfx_batch(&sXPC, format, psBatch) ;
+	printfx_unlock() ;
+	return iRV ;
+}
+#endif
+
+#if		(xpfSUPPORT_PACKED == 1)
+/*
+ * printfx_packed() - as for printfx() with packed arguments, see xpcprintfx_packed()
+ */
+int printfx_packed(const char * format, const void * pArgs) {
+	xpc_t	sXPC ;
+	sXPC.f.maxlen	= xpfMAXLEN_MAXVAL ;
+	sXPC.f.curlen	= 0 ;
+#if		(xpfSUPPORT_ASYNC == 1)
+	if (__atomic_load_n(&PrintAsyncTask, __ATOMIC_ACQUIRE)) {
+		xpab_t	sB ;
+		vPrintAsyncBegin(&sB) ;
+		sXPC.handler	= NULL ;
+		sXPC.writer		= xPrintToAsync ;
+		sXPC.pVoid		= &sB ;
+		int iRV = xpcprintfx_packed(&sXPC, format, pArgs) ;
+		vPrintAsyncEnd(&sB) ;
+		return iRV ;
+	}
+#endif
+	sXPC.handler	= xPrintStdOut ;
+	sXPC.writer		= xPrintHandlerSpan ;
+	sXPC.pVoid		= stdout ;
+	printfx_lock() ;
+	int iRV = xpcprintfx_packed(&sXPC, format, pArgs) ;
+	printfx_unlock() ;
+	return iRV ;
+}
+#endif
+
 /*
  * vnprintfx_nolock() - print to stdout without any semaphore locking.
  * 					securing the channel must be done manually
@@ -1275,6 +3239,24 @@ int printfx_nolock(const char * format, ...) {
 	return iRV ;
 }
 
+/*
+ * printfx_span_nolock() - as printfx_span() but synchronous & without locking, caller holds printfx_lock()
+ * 					records queued by the asynchronous pipeline are output first, order is kept
+ */
+int printfx_span_nolock(const char * pStr, size_t szLen) {
+	xpc_t	sXPC ;
+	sXPC.handler	= xPrintStdOut ;
+	sXPC.writer		= xPrintHandlerSpan ;
+	sXPC.pVoid		= stdout ;
+	sXPC.f.maxlen	= xpfMAXLEN_MAXVAL ;
+	sXPC.f.curlen	= 0 ;
+#if		(xpfSUPPORT_ASYNC == 1)
+	if (__atomic_load_n(&PrintAsyncTask, __ATOMIC_ACQUIRE) && xPrintAsyncHolder()) vPrintAsyncDrain() ;
+#endif
+	vPrintSpanRef(&sXPC, pStr, szLen) ;
+	return sXPC.f.curlen ;
+}
+
 /* ################################# Destination - String buffer or STDOUT #########################
  * * Based on the values (pre) initialised for buffer start and size
  * a) walk through the buffer on successive calls, concatenating output; or
@@ -1304,9 +3286,23 @@ int	wsnprintfx(char ** ppcBuf, size_t * pSize, const char * pcFormat, ...) {
 
 // ################################### Destination = FILE PTR ######################################
 
-int	xPrintToFile(xpc_t * psXPC, int cChr) { return fputc(cChr, psXPC->stream) ; }
+/* The stream is locked ONCE per call, spans written without further locking. This also makes
+ * the complete formatted output atomic with respect to other threads using the same stream.
+ * glibc & newlib (ESP-IDF) provide fwrite_unlocked(), elsewhere fwrite() relocks recursively */
+#if		defined(__GLIBC__) || defined(_NEWLIB_VERSION)
+	#define	xpfFWRITE		fwrite_unlocked
+#else
+	#define	xpfFWRITE		fwrite
+#endif
+
+int	xPrintToFile(xpc_t * psXPC, const char * pStr, size_t szLen) { return xpfFWRITE(pStr, 1, szLen, psXPC->stream) ; }
 
-int vfprintfx(FILE * stream, const char * format, va_list vArgs) { return xprintfx(xPrintToFile, stream, xpfMAXLEN_MAXVAL, format, vArgs); }
+int vfprintfx(FILE * stream, const char * format, va_list vArgs) {
+	flockfile(stream) ;
+	int iRV = xprintfx_span(xPrintToFile, stream, xpfMAXLEN_MAXVAL, format, vArgs) ;
+	funlockfile(stream) ;
+	return iRV ;
+}
 
 int fprintfx(FILE * stream, const char * format, ...) {
 	va_list vArgs ;
@@ -1316,15 +3312,130 @@ int fprintfx(FILE * stream, const char * format, ...) {
 	return count ;
 }
 
+/*
+ * fprintfx_span() - output already formatted, written as is with a single fwrite()
+ */
+int fprintfx_span(FILE * stream, const char * pStr, size_t szLen) { return fwrite(pStr, 1, szLen, stream) ; }
+
+#if		(xpfSUPPORT_PACKED == 1)
+/*
+ * fprintfx_packed() - as for fprintfx() with packed arguments, see xpcprintfx_packed()
+ */
+int fprintfx_packed(FILE * stream, const char * format, const void * pArgs) {
+	xpc_t	sXPC ;
+	sXPC.handler	= NULL ;
+	sXPC.writer		= xPrintToFile ;
+	sXPC.stream		= stream ;
+	sXPC.f.maxlen	= xpfMAXLEN_MAXVAL ;
+	sXPC.f.curlen	= 0 ;
+	flockfile(stream) ;
+	int iRV = xpcprintfx_packed(&sXPC, format, pArgs) ;
+	funlockfile(stream) ;
+	return iRV ;
+}
+#endif
+
 // ################################### Destination = HANDLE ########################################
 
-int	xPrintToHandle(xpc_t * psXPC, int cChr) {
-	char cChar = cChr ;
-	int size = write(psXPC->fd, &cChar, sizeof(cChar)) ;
-	return size == 1 ? cChr : size ;
+/* Output is staged in a buffer and written with a single write/writev per call (or buffer full).
+ * Per call (dprintfx) string arguments & format literals of xpfFD_IOV_MIN or more characters are
+ * not copied but referenced by their own iovec, valid since they cannot change before the call
+ * returns. Persistent buffers (bdprintfx) outlive the call so ALWAYS copy. */
+
+#ifdef	ESP_PLATFORM									// VFS has no writev(), one write per iovec
+	typedef	struct xpfiov_t { void * iov_base ; size_t iov_len ; } xpfiov_t ;
+#else
+	typedef	struct iovec xpfiov_t ;
+#endif
+
+typedef	struct xpfv_t {									// per call writev context
+	xpfb_t *		psFB ;
+	int				Error ;								// 1st write error, if any
+	uint16_t		Mark ;								// start of Buf[] not yet in sIOV[]
+	uint8_t			Count ;								// sIOV[] entries in use
+	xpfiov_t		sIOV[xpfFD_IOV_MAX] ;
+} xpfv_t ;
+
+/**
+ * xPrintWriteV() - write a series of iovecs completely, handling partial writes
+ * \return	total number of characters written or -1 on error
+ */
+static	int	xPrintWriteV(int fd, xpfiov_t * psIOV, int Count) {
+	int Total = 0 ;
+	while (Count) {
+	#ifdef	ESP_PLATFORM								// VFS has no writev(), one write per iovec
+		ssize_t iRV = psIOV->iov_len ? write(fd, psIOV->iov_base, psIOV->iov_len) : 0 ;
+	#else
+		ssize_t iRV = writev(fd, psIOV, Count) ;
+	#endif
+		if (iRV < 0) {
+			if (errno == EINTR) continue ;
+			return iRV ;
+		}
+		if (iRV == 0 && psIOV->iov_len) return Total ;	// nothing accepted, give up
+		Total += iRV ;
+		while (Count && (size_t) iRV >= psIOV->iov_len) {	// skip completed iovecs
+			iRV -= psIOV->iov_len ;
+			++psIOV ;
+			--Count ;
+		}
+		if (Count) {									// partial, adjust remaining iovec
+			psIOV->iov_base = (char *) psIOV->iov_base + iRV ;
+			psIOV->iov_len -= iRV ;
+		}
+	}
+	return Total ;
+}
+
+static	void vPrintFdFlushV(xpfv_t * psV) {
+	xpfb_t * psFB = psV->psFB ;
+	if (psFB->Used > psV->Mark) {						// close the last buffered segment
+		psV->sIOV[psV->Count].iov_base = &psFB->Buf[psV->Mark] ;
+		psV->sIOV[psV->Count++].iov_len = psFB->Used - psV->Mark ;
+	}
+	if (psV->Count) {
+		int iRV = xPrintWriteV(psFB->fd, psV->sIOV, psV->Count) ;
+		if (iRV < 0 && psV->Error == 0) psV->Error = iRV ;
+	}
+	psV->Count = 0 ;
+	psV->Mark = psFB->Used = 0 ;
+}
+
+int	xPrintToHandleV(xpc_t * psXPC, const char * pStr, size_t szLen) {
+	xpfv_t * psV = psXPC->pVoid ;
+	xpfb_t * psFB = psV->psFB ;
+	if (psXPC->f.stable && szLen >= xpfFD_IOV_MIN) {	// reference, don't copy
+		if (psV->Count > (xpfFD_IOV_MAX - 3)) vPrintFdFlushV(psV) ;	// room for 2 segments & reference
+		if (psFB->Used > psV->Mark) {
+			psV->sIOV[psV->Count].iov_base = &psFB->Buf[psV->Mark] ;
+			psV->sIOV[psV->Count++].iov_len = psFB->Used - psV->Mark ;
+			psV->Mark = psFB->Used ;
+		}
+		psV->sIOV[psV->Count].iov_base = (void *) pStr ;
+		psV->sIOV[psV->Count++].iov_len = szLen ;
+		return szLen ;
+	}
+	if (szLen > (sizeof(psFB->Buf) - psFB->Used)) {
+		vPrintFdFlushV(psV) ;
+		if (szLen >= sizeof(psFB->Buf)) {				// too big to stage, write directly
+			xpfiov_t sIOV = { .iov_base = (void *) pStr, .iov_len = szLen } ;
+			int iRV = xPrintWriteV(psFB->fd, &sIOV, 1) ;
+			if (iRV < 0 && psV->Error == 0) psV->Error = iRV ;
+			return szLen ;
+		}
+	}
+	memcpy(&psFB->Buf[psFB->Used], pStr, szLen) ;
+	psFB->Used += szLen ;
+	return szLen ;
 }
 
-int	vdprintfx(int fd, const char * format, va_list vArgs) { return xprintfx(xPrintToHandle, (void *) fd, xpfMAXLEN_MAXVAL, format, vArgs) ; }
+int	vdprintfx(int fd, const char * format, va_list vArgs) {
+	xpfb_t	sFB = { .fd = fd, .Used = 0 } ;
+	xpfv_t	sV = { .psFB = &sFB, .Error = 0, .Mark = 0, .Count = 0 } ;
+	int iRV = xprintfx_span(xPrintToHandleV, &sV, xpfMAXLEN_MAXVAL, format, vArgs) ;
+	vPrintFdFlushV(&sV) ;
+	return sV.Error ? sV.Error : iRV ;
+}
 
 int	dprintfx(int fd, const char * format, ...) {
 	va_list	vArgs ;
@@ -1334,6 +3445,227 @@ int	dprintfx(int fd, const char * format, ...) {
 	return count ;
 }
 
+/*
+ * dprintfx_span() - output already formatted, written as is with a single write, partial writes resumed
+ */
+int	dprintfx_span(int fd, const char * pStr, size_t szLen) {
+	xpfiov_t sIOV = { .iov_base = (void *) pStr, .iov_len = szLen } ;
+	return xPrintWriteV(fd, &sIOV, 1) ;
+}
+
+#if		(xpfSUPPORT_BATCH == 1)
+/*
+ * dprintfx_batch() - records of a batch to a file descriptor, staged as for dprintfx()
+ */
+int	dprintfx_batch(int fd, const char * format, xpb_t * psBatch) {
+	xpfb_t	sFB = { .fd = fd, .Used = 0 } ;
+	xpfv_t	sV = { .psFB = &sFB, .Error = 0, .Mark = 0, .Count = 0 } ;
+	xpc_t	sXPC ;
+	sXPC.handler	= NULL ;
+	sXPC.writer		= xPrintToHandleV ;
+	sXPC.pVoid		= &sV ;
+	sXPC.f.maxlen	= 0 ;								// no limit, see xpcprintfx_batch()
+	sXPC.f.curlen	= 0 ;
+	int iRV = xpcprintfx_batch(&sXPC, format, psBatch) ;
+	vPrintFdFlushV(&sV) ;
+	return sV.Error ? sV.Error : iRV ;
+}
+#endif
+
+#if		(xpfSUPPORT_PACKED == 1)
+/*
+ * dprintfx_packed() - as for dprintfx() with packed arguments, see xpcprintfx_packed()
+ */
+int	dprintfx_packed(int fd, const char * format, const void * pArgs) {
+	xpfb_t	sFB = { .fd = fd, .Used = 0 } ;
+	xpfv_t	sV = { .psFB = &sFB, .Error = 0, .Mark = 0, .Count = 0 } ;
+	xpc_t	sXPC ;
+	sXPC.handler	= NULL ;
+	sXPC.writer		= xPrintToHandleV ;
+	sXPC.pVoid		= &sV ;
+	sXPC.f.maxlen	= xpfMAXLEN_MAXVAL ;
+	sXPC.f.curlen	= 0 ;
+	int iRV = xpcprintfx_packed(&sXPC, format, pArgs) ;
+	vPrintFdFlushV(&sV) ;
+	return sV.Error ? sV.Error : iRV ;
+}
+#endif
+
+/**
+ * vPrintFdInit() - initialise a persistent buffer for high rate output to a file descriptor
+ * 		Not locked, the caller must serialise use of the buffer & call xPrintFdFlush() when required
+ */
+void	vPrintFdInit(xpfb_t * psFB, int fd) {
+	psFB->fd	= fd ;
+	psFB->Used	= 0 ;
+}
+
+/**
+ * xPrintFdFlush() - write any buffered output
+ * \return	number of characters written or -1 on error
+ */
+int		xPrintFdFlush(xpfb_t * psFB) {
+	if (psFB->Used == 0) return 0 ;
+	xpfiov_t sIOV = { .iov_base = psFB->Buf, .iov_len = psFB->Used } ;
+	psFB->Used = 0 ;
+	return xPrintWriteV(psFB->fd, &sIOV, 1) ;
+}
+
+int	xPrintToHandleBuf(xpc_t * psXPC, const char * pStr, size_t szLen) {
+	xpfb_t * psFB = psXPC->pVoid ;
+	if (szLen > (sizeof(psFB->Buf) - psFB->Used)) {
+		if (xPrintFdFlush(psFB) < 0) return EOF ;
+		if (szLen >= sizeof(psFB->Buf)) {				// too big to stage, write directly
+			xpfiov_t sIOV = { .iov_base = (void *) pStr, .iov_len = szLen } ;
+			return xPrintWriteV(psFB->fd, &sIOV, 1) ;
+		}
+	}
+	memcpy(&psFB->Buf[psFB->Used], pStr, szLen) ;
+	psFB->Used += szLen ;
+	return szLen ;
+}
+
+int	vbdprintfx(xpfb_t * psFB, const char * format, va_list vArgs) {
+	return xprintfx_span(xPrintToHandleBuf, psFB, xpfMAXLEN_MAXVAL, format, vArgs) ;
+}
+
+int	bdprintfx(xpfb_t * psFB, const char * format, ...) {
+	va_list	vArgs ;
+	va_start(vArgs, format) ;
+	int count = vbdprintfx(psFB, format, vArgs) ;
+	va_end(vArgs) ;
+	return count ;
+}
+
+#if		(xpfSUPPORT_HEXDUMP == 1) && (xpfSUPPORT_HEXDUMP_MT == 1) && defined(__linux__)
+/* ################################ Multi threaded hexdump (Linux) #################################
+ * Every complete row of a multi row dump has the same length for a given spec (value size, form,
+ * address & '+' flags), row N starts at N * RowLen in the output. Complete rows are split into
+ * ranges, each formatted by its own thread into its final position, the partial last row (if any)
+ * by the caller. '=' (squeeze) makes positions data dependent and is NOT supported.
+ */
+
+typedef	struct xpdw_t {									// hexdump worker, range of complete rows
+	pthread_t		Thread ;
+	xpc_t			sXPC ;								// string sink at the first row
+	const char *	pSrc ;								// first byte of the range
+	size_t			Offset ;							// of pSrc in the buffer, relative address
+	size_t			Rows ;
+	uint8_t			Started ;
+} xpdw_t ;
+
+static	void * pvPrintDumpWorker(void * pvPara) {
+	xpdw_t * psW = pvPara ;
+	const char * pRow = psW->pSrc ;
+	for (size_t Row = 0; Row < psW->Rows; ++Row, pRow += xpfHEXDUMP_WIDTH) {
+		vPrintHexDumpRow(&psW->sXPC, pRow, xpfHEXDUMP_WIDTH, psW->sXPC.f.rel_val ?
+			(void *) (uintptr_t) (psW->Offset + Row * xpfHEXDUMP_WIDTH) : (void *) pRow, 1) ;
+	}
+	return NULL ;
+}
+
+/**
+ * xPrintHexDumpMT()
+ * \brief		hexdump a (large) buffer using multiple threads, output identical to vPrintHexDump()
+ * \param[in]	pBuf - output buffer, NOT terminated, NULL to only calculate the size required
+ * \param[in]	Size - size of the output buffer
+ * \param[in]	pcSpec - hexdump conversion, eg "%'+B" or "%!llW", NOT '=' or '*'
+ * \param[in]	pvSrc - pointer to memory to be dumped
+ * \param[in]	Len - number of bytes to dump
+ * \param[in]	Threads - maximum number of threads, incl the caller, at least xpfDUMP_ROWS_MIN rows each
+ * \return		length of the dump or erFAILURE if spec not supported or output buffer too small
+ */
+int64_t	xPrintHexDumpMT(char * pBuf, size_t Size, const char * pcSpec, const void * pvSrc, size_t Len, int Threads) {
+	xpdw_t	sW[xpfDUMP_THREADS_MAX] ;
+	char	Tail[xpfMAX_LEN_DUMP] ;
+	xpo_t	sOp ;
+	xpc_t	sXPC ;
+	if (*pcSpec != '%') return erFAILURE ;
+	pcPrintParseSpec(&sOp, pcSpec + 1) ;
+	if ((sOp.cFmt != CHR_B && sOp.cFmt != CHR_H && sOp.cFmt != CHR_W) || sOp.Args || (sOp.flags & xpfFLAG_SQUEEZE))
+		return erFAILURE ;
+	sXPC.handler	= NULL ;
+	sXPC.writer		= xPrintToStringSpan ;
+	sXPC.f.limits	= sOp.limits ;
+	sXPC.f.flags	= sOp.flags ;
+	vPrintHexDumpForm(&sXPC, sOp.cFmt) ;
+	sXPC.f.maxlen	= 0 ;								// no limit, output sized below
+
+	// render the 1st complete row & the partial last row once, for their lengths
+	const char * pSrc = pvSrc ;
+	size_t	Rows = Len / xpfHEXDUMP_WIDTH ;
+	int		Rest = Len % xpfHEXDUMP_WIDTH ;
+	int		Multi = Len > xpfHEXDUMP_WIDTH ;
+	int		RowLen = 0, TailLen = 0 ;
+	if (Rows) {
+		sXPC.pStr		= Tail ;
+		sXPC.f.curlen	= 0 ;
+		vPrintHexDumpRow(&sXPC, pSrc, xpfHEXDUMP_WIDTH, sXPC.f.rel_val ? NULL : (void *) pSrc, Multi) ;
+		RowLen = sXPC.f.curlen ;
+	}
+	if (Rest) {
+		const char * pRow = pSrc + Rows * xpfHEXDUMP_WIDTH ;
+		sXPC.pStr		= Tail ;
+		sXPC.f.curlen	= 0 ;
+		vPrintHexDumpRow(&sXPC, pRow, Rest, sXPC.f.rel_val ? (void *) (uintptr_t) (Rows * xpfHEXDUMP_WIDTH) : (void *) pRow, Multi) ;
+		TailLen = sXPC.f.curlen ;
+	}
+	int64_t	Total = (int64_t) Rows * RowLen + TailLen ;
+	if (pBuf == NULL) return Total ;
+	if (Total > (int64_t) Size) return erFAILURE ;
+	memcpy(pBuf + Rows * RowLen, Tail, TailLen) ;
+
+	// split the complete rows, the caller formats the 1st range
+	if (Threads > xpfDUMP_THREADS_MAX) Threads = xpfDUMP_THREADS_MAX ;
+	if ((size_t) Threads > Rows / xpfDUMP_ROWS_MIN) Threads = Rows / xpfDUMP_ROWS_MIN ;
+	if (Threads < 1) Threads = 1 ;
+	size_t	First = 0 ;
+	for (int Idx = 0; Idx < Threads; ++Idx) {
+		xpdw_t * psW = &sW[Idx] ;
+		psW->sXPC		= sXPC ;
+		psW->sXPC.pStr	= pBuf + First * RowLen ;
+		psW->sXPC.f.curlen = 0 ;
+		psW->pSrc		= pSrc + First * xpfHEXDUMP_WIDTH ;
+		psW->Offset		= First * xpfHEXDUMP_WIDTH ;
+		psW->Rows		= (Rows / Threads) + ((size_t) Idx < (Rows % Threads) ? 1 : 0) ;
+		psW->Started	= Idx ? pthread_create(&psW->Thread, NULL, pvPrintDumpWorker, psW) == 0 : 0 ;
+		First += psW->Rows ;
+	}
+	pvPrintDumpWorker(&sW[0]) ;
+	for (int Idx = 1; Idx < Threads; ++Idx) {
+		if (sW[Idx].Started)
+			pthread_join(sW[Idx].Thread, NULL) ;
+		else
+			pvPrintDumpWorker(&sW[Idx]) ;				// thread not created, do it here
+	}
+	return Total ;
+}
+
+/**
+ * xPrintHexDumpFile()
+ * \brief		hexdump a (large) buffer using multiple threads directly into a regular file, at the
+ * 				current file offset which is advanced as by write()
+ * \param[in]	fd - file descriptor, opened read/write, MUST support ftruncate() & mmap()
+ * \return		length of the dump or erFAILURE
+ */
+int64_t	xPrintHexDumpFile(int fd, const char * pcSpec, const void * pvSrc, size_t Len, int Threads) {
+	struct stat	sStat ;
+	int64_t	Total = xPrintHexDumpMT(NULL, 0, pcSpec, pvSrc, Len, Threads) ;
+	if (Total <= 0) return Total ;
+	off_t	Base = lseek(fd, 0, SEEK_CUR) ;
+	if (Base < 0 || fstat(fd, &sStat) < 0) return erFAILURE ;
+	if (sStat.st_size < (Base + Total) && ftruncate(fd, Base + Total) < 0) return erFAILURE ;
+	off_t	Page = Base & ~((off_t) sysconf(_SC_PAGESIZE) - 1) ;	// mapping MUST start page aligned
+	size_t	Map = (Base - Page) + Total ;
+	char *	pMap = mmap(NULL, Map, PROT_READ | PROT_WRITE, MAP_SHARED, fd, Page) ;
+	if (pMap == MAP_FAILED) return erFAILURE ;
+	Total = xPrintHexDumpMT(pMap + (Base - Page), Total, pcSpec, pvSrc, Len, Threads) ;
+	munmap(pMap, Map) ;
+	if (Total > 0) lseek(fd, Base + Total, SEEK_SET) ;
+	return Total ;
+}
+#endif
+
 #ifdef	ESP_PLATFORM
 /* ################################## Destination = UART/TELNET ####################################
  * Output directly to the [possibly redirected] stdout/UART channel
@@ -1368,20 +3700,66 @@ int devprintfx(int (* Hdlr)(int ), const char * format, ...) {
 }
 
 /* #################################### Destination : SOCKET #######################################
- * SOCKET directed formatted print support. Problem here is that MSG_MORE is primarily supported on
- * TCP sockets, UDP support officially in LwIP 2.6 but has not been included into ESP-IDF yet. */
+ * SOCKET directed formatted print support. Output is staged in a small stack buffer and sent each
+ * time it fills, all but the last chunk with MSG_MORE. Problem here is that MSG_MORE is primarily
+ * supported on TCP sockets, UDP support officially in LwIP 2.6 but has not been included into
+ * ESP-IDF yet. Return values are as before, the count formatted or erFAILURE if psSock->error set */
+
+typedef	struct xpfs_t {									// socket staging context
+	netx_t *	psSock ;
+	int			Flags ;									// socket flags at entry
+	uint16_t	Used ;
+	uint8_t		Fail ;									// write failed, drop rest of output
+	char		Buf[xpfSOCK_BUF_SIZE] ;
+} xpfs_t ;
 
-int	xPrintToSocket(xpc_t * psXPC, int cChr) {
-	char cBuf = cChr ;
-	if (xNetWrite(psXPC->psSock, &cBuf, sizeof(cBuf))) return EOF ;
-	return cChr ;
+/**
+ * vPrintSockFlush() - send the staged chunk, looping on partial writes
+ * 		xNetWrite() returns the count sent, on error (<= 0) it has recorded the cause in
+ * 		psSock->error and the rest of the output is dropped
+ */
+static	void vPrintSockFlush(xpfs_t * psS, int Flags) {
+	char *	pBuf = psS->Buf ;
+	int		Len = psS->Used ;
+	psS->Used = 0 ;
+	psS->psSock->flags = Flags ;
+	while (Len > 0 && psS->Fail == 0) {
+		int iRV = xNetWrite(psS->psSock, pBuf, Len) ;
+		if (iRV <= 0) {
+			psS->Fail = 1 ;
+			break ;
+		}
+		pBuf += iRV ;
+		Len -= iRV ;
+	}
+}
+
+int	xPrintToSocketSpan(xpc_t * psXPC, const char * pStr, size_t szLen) {
+	xpfs_t * psS = psXPC->pVoid ;
+	if (psS->Fail) return EOF ;
+	size_t	Left = szLen ;
+	while (Left) {
+		size_t Now = sizeof(psS->Buf) - psS->Used ;
+		Now = Now > Left ? Left : Now ;
+		memcpy(&psS->Buf[psS->Used], pStr, Now) ;
+		psS->Used += Now ;
+		pStr += Now ;
+		Left -= Now ;
+		if (psS->Used == sizeof(psS->Buf))				// full chunk, more to follow
+			vPrintSockFlush(psS, psS->Flags | MSG_MORE) ;
+	}
+	return szLen ;
 }
 
 int vsocprintfx(netx_t * psSock, const char * format, va_list vArgs) {
-	int	Fsav	= psSock->flags ;
-	psSock->flags	|= MSG_MORE ;
-	int iRV = xprintfx(xPrintToSocket, psSock, xpfMAXLEN_MAXVAL, format, vArgs) ;
-	psSock->flags	= Fsav ;
+	xpfs_t	sS ;
+	sS.psSock	= psSock ;
+	sS.Flags	= psSock->flags ;
+	sS.Used		= 0 ;
+	sS.Fail		= 0 ;
+	int iRV = xprintfx_span(xPrintToSocketSpan, &sS, xpfMAXLEN_MAXVAL, format, vArgs) ;
+	vPrintSockFlush(&sS, sS.Flags) ;					// last (partial) chunk, original flags
+	psSock->flags	= sS.Flags ;
 	return (psSock->error == 0) ? iRV : erFAILURE ;
 }
 
@@ -1393,12 +3771,52 @@ int socprintfx(netx_t * psSock, const char * format, ...) {
 	return count ;
 }
 
+#if		(xpfSUPPORT_BATCH == 1)
+/*
+ * socprintfx_batch() - records of a batch to a socket staged & sent with MSG_MORE, eg HTTP table export
+ */
+int socprintfx_batch(netx_t * psSock, const char * format, xpb_t * psBatch) {
+	xpfs_t	sS ;
+	xpc_t	sXPC ;
+	sS.psSock		= psSock ;
+	sS.Flags		= psSock->flags ;
+	sS.Used			= 0 ;
+	sS.Fail			= 0 ;
+	sXPC.handler	= NULL ;
+	sXPC.writer		= xPrintToSocketSpan ;
+	sXPC.pVoid		= &sS ;
+	sXPC.f.maxlen	= 0 ;								// no limit, see xpcprintfx_batch()
+	sXPC.f.curlen	= 0 ;
+	int iRV = xpcprintfx_batch(&sXPC, format, psBatch) ;
+	vPrintSockFlush(&sS, sS.Flags) ;
+	psSock->flags	= sS.Flags ;
+	return (psSock->error == 0) ? iRV : erFAILURE ;
+}
+#endif
+
 // #################################### Destination : UBUF #########################################
 
-int	xPrintToUBuf(xpc_t * psXPC, int cChr) { return xUBufPutC(psXPC->psUBuf, cChr) ; }
+/* Output is copied into the ring in contiguous blocks reserved & committed through the x_ubuf API,
+ * at most 2 per span on wrap. The space available when the call starts is used as maxlen, output
+ * beyond that is truncated as before. Blocks are visible to readers as soon as committed */
+
+int	xPrintToUBuf(xpc_t * psXPC, const char * pStr, size_t szLen) {
+	ubuf_t * psUBuf = psXPC->psUBuf ;
+	size_t	Left = szLen ;
+	while (Left) {
+		int	Now = xUBufBlockSpace(psUBuf, Left) ;		// contiguous space at the write index
+		if (Now <= 0) break ;							// full, another writer got there first
+		memcpy(pcUBufTellWrite(psUBuf), pStr, Now) ;
+		vUBufStepWrite(psUBuf, Now) ;					// commit, update index, count & signal
+		pStr += Now ;
+		Left -= Now ;
+	}
+	return szLen - Left ;
+}
 
 int	vuprintfx(ubuf_t * psUBuf, const char * format, va_list vArgs) {
-	return xprintfx(xPrintToUBuf, psUBuf, xUBufSpace(psUBuf), format, vArgs) ;
+	int	Space = xUBufSpace(psUBuf) ;
+	return (Space > 0) ? xprintfx_span(xPrintToUBuf, psUBuf, Space, format, vArgs) : 0 ;	// 0 = unlimited
 }
 
 int	uprintfx(ubuf_t * psUBuf, const char * format, ...) {
@@ -1410,6 +3828,449 @@ int	uprintfx(ubuf_t * psUBuf, const char * format, ...) {
 }
 #endif		// ESP_PLATFORM
 
+#if		(xpfSUPPORT_DEFERRED == 1)
+/* ############################### Deferred (binary) capture #######################################
+ * The caller only stores the format pointer and the raw argument values in a lock free, multi
+ * producer byte ring. Argument sizes come from a pre-scan of the format (the cached program if
+ * available) so ll, '*', %B length+pointer pairs etc are handled. Data referenced by a pointer
+ * argument (%s %U %m %B %H %W %Y %D %T %Z) is copied in, it may not survive until formatted.
+ * xPrintDeferredDrain(), from an idle hook or low priority task, formats the records to stdout
+ * (or a FILE) in capture order. A record that does not fit in the ring is dropped and counted. */
+
+typedef	struct xpdc_t {									// capture cursor
+	uint8_t *	pNow ;
+	uint8_t *	pEnd ;
+	uint8_t		Trunc ;									// data block(s) shortened to fit
+} xpdc_t ;
+
+DUMB_STATIC_ASSERT((xpfDEFER_BUF_SIZE & (xpfDEFER_BUF_SIZE - 1)) == 0) ;
+DUMB_STATIC_ASSERT(xpfDEFER_REC_MAX < xpfDEFER_BUF_SIZE && (xpfDEFER_REC_MAX % xpfDEFER_ALIGN) == 0) ;
+
+static	uint8_t				sPrintDeferRing[xpfDEFER_BUF_SIZE] __attribute__((aligned(xpfDEFER_ALIGN))) ;
+static	uint32_t			PrintDeferHead, PrintDeferTail ;
+static	SemaphoreHandle_t	printfxDeferMux = NULL ;
+static	xpds_t				sPrintDeferStats ;
+
+static	int	xPrintDeferVal(xpdc_t * psC, const void * pVal, size_t Len) {
+	if ((size_t) (psC->pEnd - psC->pNow) < Len) return 0 ;
+	memcpy(psC->pNow, pVal, Len) ;
+	psC->pNow += Len ;
+	return 1 ;
+}
+
+/**
+ * xPrintDeferData() - capture pointer value, U16 length & copy of the data referenced
+ * \param	pVoid - pointer to data
+ * 			Len - size of data, for strings the maximum length
+ * 			Str - 1 if NUL terminated string, copy includes the terminator
+ * \return	length of data copied or erFAILURE if no space
+ */
+static	int	xPrintDeferData(xpdc_t * psC, const void * pVoid, int Len, int Str) {
+	if (xPrintDeferVal(psC, &pVoid, sizeof(pVoid)) == 0) return erFAILURE ;
+	int Room = (psC->pEnd - psC->pNow) - (int) sizeof(uint16_t) - Str ;
+	if (Room < 0) return erFAILURE ;
+	int Now = (pVoid == NULL) ? 0 : Len > Room ? Room : Len ;
+	if (Str && pVoid) {
+		Now = xstrnlen(pVoid, Now) ;
+		if (Now == Room && Room < Len && ((const char *) pVoid)[Now]) psC->Trunc = 1 ;
+	} else if (Now < Len) {
+		psC->Trunc = 1 ;
+	}
+	uint16_t Size = Now + Str ;
+	memcpy(psC->pNow, &Size, sizeof(Size)) ;
+	memcpy(psC->pNow + sizeof(Size), pVoid, Now) ;
+	psC->pNow += sizeof(Size) + Now ;
+	if (Str) *psC->pNow++ = 0 ;
+	return Now ;
+}
+
+/**
+ * xPrintDeferOp() - capture the argument(s) of a single instruction, mirrors vPrintOp()
+ * \return	1 if captured, 0 if the record is full
+ */
+static	int	xPrintDeferOp(xpdc_t * psC, const xpo_t * psOp, xpa_t * psArgs) {
+	x64_t	x64Val ;
+	px_t	px ;
+	int		Siz ;
+	xpf_t	f ;
+	if (psOp->cFmt == 0) return 1 ;
+	f.limits	= psOp->limits ;
+	f.flags		= psOp->flags ;
+#if		(xpfSUPPORT_ARRAYS == 1)
+	int Count = psOp->Count ;
+	if (psOp->Args & xpoARG_COUNT) {
+		Count = va_arg(psArgs->vArgs, int) ;
+		if (xPrintDeferVal(psC, &Count, sizeof(Count)) == 0) return 0 ;
+	}
+#endif
+	if (psOp->Args & xpoARG_WIDTH) {
+		Siz = va_arg(psArgs->vArgs, int) ;
+		if (xPrintDeferVal(psC, &Siz, sizeof(Siz)) == 0) return 0 ;
+	}
+	if (psOp->Args & xpoARG_PRECIS) {
+		Siz = va_arg(psArgs->vArgs, int) ;
+		f.precis = Siz ;
+		if (xPrintDeferVal(psC, &Siz, sizeof(Siz)) == 0) return 0 ;
+	}
+#if		(xpfSUPPORT_ARRAYS == 1)
+	if (psOp->Args & xpoARG_ARRAY) {					// elements copied, as many as fit
+		px.pv = va_arg(psArgs->vArgs, void *) ;
+		int Len = xPrintDeferData(psC, px.pv, Count * xPrintArraySize(psOp), 0) ;
+		return Len != erFAILURE && (Len > 0 || Count == 0 || px.pv == NULL) ;
+	}
+#endif
+	switch (psOp->cFmt) {
+#if		(xpfSUPPORT_SGR == 1)
+	case CHR_C:
+#endif
+#if		(xpfSUPPORT_IP_ADDR == 1)
+	case CHR_I:
+#endif
+#if		(xpfSUPPORT_DATETIME == 1)
+	case CHR_r:
+#endif
+	case CHR_c:
+		x64Val.x32[0].u32 = va_arg(psArgs->vArgs, uint32_t) ;
+		return xPrintDeferVal(psC, &x64Val.x32[0].u32, sizeof(uint32_t)) ;
+
+#if		(xpfSUPPORT_BINARY == 1)
+	case CHR_J:
+#endif
+	case CHR_d:
+	case CHR_i:
+	case CHR_o:
+	case CHR_x:
+	case CHR_u:
+		if (f.llong) {
+			x64Val.u64 = va_arg(psArgs->vArgs, uint64_t) ;
+			return xPrintDeferVal(psC, &x64Val.u64, sizeof(uint64_t)) ;
+		}
+		x64Val.x32[0].u32 = va_arg(psArgs->vArgs, uint32_t) ;
+		return xPrintDeferVal(psC, &x64Val.x32[0].u32, sizeof(uint32_t)) ;
+
+#if		(xpfSUPPORT_DATETIME == 1)
+	case CHR_R:
+		x64Val.u64 = va_arg(psArgs->vArgs, uint64_t) ;
+		return xPrintDeferVal(psC, &x64Val.u64, sizeof(uint64_t)) ;
+
+	case CHR_D:											// TSZ_t copied, zone info referenced
+	case CHR_T:
+	case CHR_Z:
+		px.pv = va_arg(psArgs->vArgs, TSZ_t *) ;
+		return xPrintDeferData(psC, px.pv, sizeof(TSZ_t), 0) == sizeof(TSZ_t) ;
+#endif
+
+#if		(xpfSUPPORT_URL == 1)
+	case CHR_U:
+		px.pc8 = va_arg(psArgs->vArgs, char *) ;
+		return xPrintDeferData(psC, px.pv, xpfMAXLEN_MAXVAL, 1) != erFAILURE ;
+#endif
+
+#if		(xpfSUPPORT_HEXDUMP == 1)
+	case CHR_Y:
+		px.pv = va_arg(psArgs->vArgs, xpd_t *) ;		// context referenced, updated when drained
+		if (xPrintDeferVal(psC, &px.pv, sizeof(px.pv)) == 0) return 0 ;
+		if (xPrintDeferVal(psC, &((xpd_t *) px.pv)->Size, sizeof(uint8_t)) == 0) return 0 ;
+		/* FALLTHRU */ /* no break */
+	case CHR_B:
+	case CHR_H:
+	case CHR_W:
+		Siz = va_arg(psArgs->vArgs, int) ;
+		px.pc8 = va_arg(psArgs->vArgs, char *) ;
+		uint8_t * pSiz = psC->pNow ;
+		if (xPrintDeferVal(psC, &Siz, sizeof(Siz)) == 0) return 0 ;
+		int Len = xPrintDeferData(psC, px.pv, Siz, 0) ;
+		if (Len == erFAILURE || (Len == 0 && Siz > 0)) return 0 ;
+		if (Len < Siz) memcpy(pSiz, &Len, sizeof(Len)) ;	// only the captured part is dumped
+		return 1 ;
+#endif
+
+#if		(xpfSUPPORT_MAC_ADDR == 1)
+	case CHR_m:
+		px.pc8 = va_arg(psArgs->vArgs, char *) ;
+		return xPrintDeferData(psC, px.pv, lenMAC_ADDRESS, 0) == lenMAC_ADDRESS ;
+#endif
+
+#if		(xpfSUPPORT_FIXEDPOINT == 1)
+	case CHR_Q:
+	case CHR_q:
+		Siz = va_arg(psArgs->vArgs, int) ;
+		if (xPrintDeferVal(psC, &Siz, sizeof(Siz)) == 0) return 0 ;
+		if (f.llong) {
+			x64Val.u64 = va_arg(psArgs->vArgs, uint64_t) ;
+			return xPrintDeferVal(psC, &x64Val.u64, sizeof(uint64_t)) ;
+		}
+		x64Val.x32[0].u32 = va_arg(psArgs->vArgs, uint32_t) ;
+		return xPrintDeferVal(psC, &x64Val.x32[0].u32, sizeof(uint32_t)) ;
+#endif
+
+#if		(xpfSUPPORT_IEEE754 == 1)
+	case CHR_e:
+	case CHR_f:
+	case CHR_a:
+	case CHR_g:
+		x64Val.f64 = va_arg(psArgs->vArgs, double) ;
+		return xPrintDeferVal(psC, &x64Val.f64, sizeof(double)) ;
+#endif
+
+#if		(xpfSUPPORT_POINTER == 1)
+	case CHR_p:
+		px.pv = va_arg(psArgs->vArgs, void *) ;
+		return xPrintDeferVal(psC, &px.pv, sizeof(px.pv)) ;
+#endif
+
+	case CHR_s:											// NULL & invalid pointers not followed
+		px.pc8 = va_arg(psArgs->vArgs, char *) ;
+		if (halCONFIG_inMEM(px.pc8) == 0) {
+			uint16_t Size = 0 ;
+			return xPrintDeferVal(psC, &px.pv, sizeof(px.pv)) && xPrintDeferVal(psC, &Size, sizeof(Size)) ;
+		}
+		return xPrintDeferData(psC, px.pv, f.precis ? f.precis : xpfMAXLEN_MAXVAL, 1) != erFAILURE ;
+
+	default:											// no argument
+		return 1 ;
+	}
+}
+
+/**
+ * vPrintDeferredV() - capture format pointer & arguments as a record in the deferred ring
+ * \param	format - format string with static lifetime, only the pointer is stored
+ * 			vArgs - arguments, sized & copied according to the format
+ * \return	none, records that do not fit are dropped and counted
+ */
+void	vPrintDeferredV(const char * format, va_list vArgs) {
+	uint8_t	Rec[xpfDEFER_REC_MAX] __attribute__((aligned(xpfDEFER_ALIGN))) ;
+	xpdc_t	sC = { .pNow = Rec + sizeof(xpdh_t), .pEnd = Rec + sizeof(Rec), .Trunc = 0 } ;
+	xpa_t	sArgs ;
+	int		iRV = 1 ;
+	va_copy(sArgs.vArgs, vArgs) ;
+	sArgs.pArgs = NULL ;
+	sArgs.Refs	= 0 ;
+#if		(xpfSUPPORT_PROGRAMS == 1)
+	const xpp_t * psProg = psPrintProgFind(format) ;
+	if (psProg) {
+		for (int Idx = 0; iRV && Idx < psProg->Count; ++Idx) iRV = xPrintDeferOp(&sC, &psProg->Ops[Idx], &sArgs) ;
+	} else
+#endif
+	{
+		xpo_t	sOp ;
+		for (const char * fmt = pcPrintNextSpec(format); iRV && *fmt; fmt = pcPrintNextSpec(fmt)) {
+			fmt = pcPrintParseSpec(&sOp, fmt + 1) ;
+			if (*fmt == 0) break ;						// '%' ending the format
+			iRV = xPrintDeferOp(&sC, &sOp, &sArgs) ;
+			++fmt ;
+		}
+	}
+	va_end(sArgs.vArgs) ;
+	if (iRV == 0) {
+		__atomic_fetch_add(&sPrintDeferStats.Dropped, 1, __ATOMIC_RELAXED) ;
+		return ;
+	}
+	uint32_t Len = ((sC.pNow - Rec) + xpfDEFER_ALIGN - 1) & ~(xpfDEFER_ALIGN - 1) ;
+	uint32_t Pos = __atomic_load_n(&PrintDeferHead, __ATOMIC_RELAXED) ;
+	uint32_t Pad ;
+	do {												// reserve, padding to the end if the record would wrap
+		uint32_t Room = xpfDEFER_BUF_SIZE - (Pos & (xpfDEFER_BUF_SIZE - 1)) ;
+		Pad = (Room < Len) ? Room : 0 ;
+		if ((Pos + Pad + Len - __atomic_load_n(&PrintDeferTail, __ATOMIC_ACQUIRE)) > xpfDEFER_BUF_SIZE) {
+			__atomic_fetch_add(&sPrintDeferStats.Dropped, 1, __ATOMIC_RELAXED) ;
+			return ;
+		}
+	} while (__atomic_compare_exchange_n(&PrintDeferHead, &Pos, Pos + Pad + Len, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED) == 0) ;
+	if (Pad)
+		__atomic_store_n((uint32_t *) &sPrintDeferRing[Pos & (xpfDEFER_BUF_SIZE - 1)], Pad | (xpfDEFER_PAD << 16), __ATOMIC_RELEASE) ;
+	xpdh_t * psH = (xpdh_t *) &sPrintDeferRing[(Pos + Pad) & (xpfDEFER_BUF_SIZE - 1)] ;
+	psH->pcFmt = format ;
+	memcpy(psH + 1, Rec + sizeof(xpdh_t), Len - sizeof(xpdh_t)) ;
+	__atomic_store_n(&psH->Hdr, Len | (xpfDEFER_REC << 16), __ATOMIC_RELEASE) ;	// publish
+	if (sC.Trunc) __atomic_fetch_add(&sPrintDeferStats.Truncated, 1, __ATOMIC_RELAXED) ;
+}
+
+void	vPrintDeferred(const char * format, ...) {
+	va_list vArgs ;
+	va_start(vArgs, format) ;
+	vPrintDeferredV(format, vArgs) ;
+	va_end(vArgs) ;
+}
+
+/**
+ * xpcprintfx_record() - format a block of arguments captured by vPrintDeferredV()
+ * \param	psXPC - pointer to structure containing formatting and output destination info
+ * 			format - the format string used for the capture
+ * 			pArgs - captured arguments, native (this CPU) layout
+ * \return	number of characters output
+ */
+int	xpcprintfx_record(xpc_t * psXPC, const char * format, const void * pArgs) {
+	return xPrintPacked(psXPC, xpfPROG_FIND(format), format, pArgs, 0) ;
+}
+
+/**
+ * xpcprintfx_record_prog() - as xpcprintfx_record() with the program supplied by the caller, the
+ * 			program cache (global table & mutex) is not used. For decoders running in parallel.
+ * \param	psProg - program compiled from format, NULL to parse format
+ */
+int	xpcprintfx_record_prog(xpc_t * psXPC, const xpp_t * psProg, const char * format, const void * pArgs) {
+	return xPrintPacked(psXPC, psProg, format, pArgs, 0) ;
+}
+
+static	void vPrintDeferredOut(const xpdh_t * psH, FILE * stream) {
+	xpc_t	sXPC ;
+	sXPC.handler	= (stream == stdout) ? xPrintStdOut : NULL ;
+	sXPC.writer		= (stream == stdout) ? xPrintHandlerSpan : xPrintToFile ;
+	sXPC.pVoid		= stream ;
+	sXPC.f.maxlen	= xpfMAXLEN_MAXVAL ;
+	sXPC.f.curlen	= 0 ;
+	if (stream == stdout) printfx_lock() ; else flockfile(stream) ;
+	xpcprintfx_record(&sXPC, psH->pcFmt, psH + 1) ;
+	if (stream == stdout) printfx_unlock() ; else funlockfile(stream) ;
+}
+
+/**
+ * xPrintDeferredDrain() - format & output captured records, oldest first
+ * \param	stream - destination, stdout output as printfx()
+ * 			Max - maximum number of records to output, 0 for all available
+ * \return	number of records output
+ */
+int	xPrintDeferredDrain(FILE * stream, int Max) {
+	int		Count = 0 ;
+	xRtosSemaphoreTake(&printfxDeferMux, portMAX_DELAY) ;	// single consumer
+	uint32_t Pos = PrintDeferTail ;
+	while (Max == 0 || Count < Max) {
+		xpdh_t * psH = (xpdh_t *) &sPrintDeferRing[Pos & (xpfDEFER_BUF_SIZE - 1)] ;
+		uint32_t Hdr = __atomic_load_n(&psH->Hdr, __ATOMIC_ACQUIRE) ;
+		if (Hdr == 0) break ;							// empty (or oldest not yet published)
+		if ((Hdr >> 16) == xpfDEFER_REC) {
+			vPrintDeferredOut(psH, stream) ;
+			++Count ;
+		}
+		memset(psH, 0, Hdr & 0xFFFF) ;					// unpublished space reads as 0
+		Pos += Hdr & 0xFFFF ;
+		__atomic_store_n(&PrintDeferTail, Pos, __ATOMIC_RELEASE) ;	// free for producers
+	}
+	__atomic_fetch_add(&sPrintDeferStats.Records, Count, __ATOMIC_RELAXED) ;
+	xRtosSemaphoreGive(&printfxDeferMux) ;
+	return Count ;
+}
+
+/**
+ * xPrintDeferredRead() - move complete records, as captured, into a buffer to be sent off device
+ * 			and decoded on a host (see printfx_decode.c) using the firmware ELF file
+ * \param	pBuf - buffer to receive records
+ * 			Size - size of buffer
+ * \return	number of bytes of records copied, 0 if none or the oldest does not fit
+ */
+int	xPrintDeferredRead(void * pBuf, size_t Size) {
+	size_t	Used = 0 ;
+	int		Count = 0 ;
+	xRtosSemaphoreTake(&printfxDeferMux, portMAX_DELAY) ;	// single consumer
+	uint32_t Pos = PrintDeferTail ;
+	while (1) {
+		xpdh_t * psH = (xpdh_t *) &sPrintDeferRing[Pos & (xpfDEFER_BUF_SIZE - 1)] ;
+		uint32_t Hdr = __atomic_load_n(&psH->Hdr, __ATOMIC_ACQUIRE) ;
+		if (Hdr == 0) break ;							// empty (or oldest not yet published)
+		uint32_t Len = Hdr & 0xFFFF ;
+		if ((Hdr >> 16) == xpfDEFER_REC) {
+			if (Used + Len > Size) break ;
+			memcpy((uint8_t *) pBuf + Used, psH, Len) ;
+			Used += Len ;
+			++Count ;
+		}
+		memset(psH, 0, Len) ;
+		Pos += Len ;
+		__atomic_store_n(&PrintDeferTail, Pos, __ATOMIC_RELEASE) ;
+	}
+	__atomic_fetch_add(&sPrintDeferStats.Records, Count, __ATOMIC_RELAXED) ;
+	xRtosSemaphoreGive(&printfxDeferMux) ;
+	return Used ;
+}
+
+/**
+ * vPrintDeferredStats() - snapshot of the capture counters
+ */
+void	vPrintDeferredStats(xpds_t * psStats) {
+	psStats->Records	= __atomic_load_n(&sPrintDeferStats.Records, __ATOMIC_RELAXED) ;
+	psStats->Dropped	= __atomic_load_n(&sPrintDeferStats.Dropped, __ATOMIC_RELAXED) ;
+	psStats->Truncated	= __atomic_load_n(&sPrintDeferStats.Truncated, __ATOMIC_RELAXED) ;
+}
+#endif
+
+#if		(xpfSUPPORT_LOG_LEVELS == 1)
+/* ##################################### Module log levels #########################################
+ * LTRACK() / LPRINT() compare the module level with a single load before evaluating arguments */
+
+uint8_t		PrintLogLevel[xpfLOG_MODULES] = { [0 ... (xpfLOG_MODULES - 1)] = xpfLOG_LEVEL_DEFAULT } ;
+uint32_t	PrintLogSuppressed[xpfLOG_MODULES] ;
+
+/**
+ * xPrintLogLevel() - set the runtime level of a module
+ * \param	Module - module number or -1 for all modules
+ * 			Level - xpfLEVEL_NONE -> xpfLEVEL_VERBOSE
+ * \return	previous level (of module 0 if all), erFAILURE if a parameter is invalid
+ */
+int	xPrintLogLevel(int Module, int Level) {
+	if (!INRANGE(-1, Module, xpfLOG_MODULES - 1, int) || !INRANGE(xpfLEVEL_NONE, Level, xpfLEVEL_VERBOSE, int))
+		return erFAILURE ;
+	int iRV = PrintLogLevel[Module < 0 ? 0 : Module] ;
+	for (int Idx = (Module < 0) ? 0 : Module; Idx < ((Module < 0) ? xpfLOG_MODULES : Module + 1); ++Idx)
+		__atomic_store_n(&PrintLogLevel[Idx], Level, __ATOMIC_RELAXED) ;
+	return iRV ;
+}
+
+/**
+ * xPrintLogSuppressed() - number of messages suppressed by the runtime level of a module
+ * \param	Module - module number
+ * 			Reset - if non zero the counter is cleared
+ * \return	messages suppressed (since last reset)
+ */
+uint32_t xPrintLogSuppressed(int Module, int Reset) {
+	IF_myASSERT(debugPARAM, INRANGE(0, Module, xpfLOG_MODULES - 1, int)) ;
+	return Reset ? __atomic_exchange_n(&PrintLogSuppressed[Module], 0, __ATOMIC_RELAXED)
+				 : __atomic_load_n(&PrintLogSuppressed[Module], __ATOMIC_RELAXED) ;
+}
+
+/**
+ * vPrintLogReport() - list modules with a non default level or messages suppressed
+ */
+void	vPrintLogReport(void) {
+	for (int Idx = 0; Idx < xpfLOG_MODULES; ++Idx) {
+		uint32_t Count = __atomic_load_n(&PrintLogSuppressed[Idx], __ATOMIC_RELAXED) ;
+		if (Count || PrintLogLevel[Idx] != xpfLOG_LEVEL_DEFAULT)
+			printfx("Module %2d  Level %d  Suppressed %'u\n", Idx, PrintLogLevel[Idx], Count) ;
+	}
+}
+#endif
+
+#if		(xpfSUPPORT_RATE_LIMIT == 1)
+/* ################################## Call site rate limiting ######################################
+ * Token bucket in GCRA form, the state is a single theoretical arrival time (TAT) updated with CAS.
+ * Each message advances TAT by the interval, messages are suppressed while TAT is more than
+ * (Burst - 1) intervals ahead. Time in units of 1.024 mSec (RunTime >> 10) to avoid division. */
+
+/**
+ * xPrintRateCheck() - decide if a message from a rate limited call site may be output
+ * \param	psRL - call site state, zero initialised
+ * 			Rate - sustained messages per second, 1 -> 976
+ * 			Burst - messages allowed in a burst
+ * \return	0 if suppressed, else 1 + number of messages suppressed since the previous one passed
+ */
+uint32_t xPrintRateCheck(xprl_t * psRL, uint32_t Rate, uint32_t Burst) {
+	IF_myASSERT(debugPARAM, INRANGE(1, Rate, (MICROS_IN_SECOND >> 10), uint32_t) && Burst > 0) ;
+	uint32_t Now = (uint32_t) (RunTime >> 10) ;
+	uint32_t Interval = (MICROS_IN_SECOND >> 10) / Rate ;
+	uint32_t TAT = __atomic_load_n(&psRL->TAT, __ATOMIC_RELAXED) ;
+	uint32_t Base ;
+	do {
+		int32_t	Ahead = (int32_t) (TAT - Now) ;
+		Base = (Ahead < 0 || Ahead > (int32_t) (Burst * Interval)) ? Now : TAT ;	// idle or stale
+		if ((Base - Now) > (Burst - 1) * Interval) {
+			__atomic_fetch_add(&psRL->Suppressed, 1, __ATOMIC_RELAXED) ;
+			return 0 ;
+		}
+	} while (__atomic_compare_exchange_n(&psRL->TAT, &TAT, Base + Interval, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED) == 0) ;
+	return 1 + __atomic_exchange_n(&psRL->Suppressed, 0, __ATOMIC_RELAXED) ;
+}
+#endif
+
 // ############################# Aliases for NEW/STDLIB supplied functions #########################
 
 /* To make this work for esp-idf and newlib, the following modules must be removed:
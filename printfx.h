@@ -23,10 +23,23 @@ extern unsigned long long RunTime ;
 
 //#define	_TRACK_(f)						"%!.R: %s:%d " f "", RunTime, __FUNCTION__, __LINE__
 #define	_TRACK_(f)						"[%s:%d] " f "", __FUNCTION__, __LINE__
-#define	TRACK(f, ...)					printfx(_TRACK_(f), ##__VA_ARGS__)
+/* Deferred variants only capture the format pointer & arguments, formatting is done later by
+ * xPrintDeferredDrain(). Formats MUST be string literals, only the pointer is stored */
+#define	DTRACK(f, ...)					vPrintDeferred(_TRACK_(f), ##__VA_ARGS__)
+#define	IF_DTRACK(T, f, ...)			if (T) DTRACK(f, ##__VA_ARGS__)
+#define	DPRINT(f, ...)					vPrintDeferred(f, ##__VA_ARGS__)
+#define	IF_DPRINT(T, f, ...)			if (T) DPRINT(f, ##__VA_ARGS__)
+
+#define	xpfDEFERRED_MACROS				0		// 1 = TRACK() & PRINT() deferred, literal formats ONLY
+
+#if		(xpfDEFERRED_MACROS == 1)
+	#define	TRACK(f, ...)				DTRACK(f, ##__VA_ARGS__)
+	#define	PRINT(f, ...)				DPRINT(f, ##__VA_ARGS__)
+#else
+	#define	TRACK(f, ...)				printfx_cached(_TRACK_(f), ##__VA_ARGS__)
+	#define	PRINT(f, ...)				printfx(f, ##__VA_ARGS__)
+#endif
 #define	IF_TRACK(T, f, ...)				if (T) TRACK(f, ##__VA_ARGS__)
-
-#define	PRINT(f, ...)					printfx(f, ##__VA_ARGS__)
 #define	IF_PRINT(T, f, ...)				if (T) PRINT(f, ##__VA_ARGS__)
 
 /* The direct output functions are intended to be used to debug tasks that work
@@ -48,8 +61,111 @@ extern unsigned long long RunTime ;
 #define	xpfSUPPORT_SCALING				1		// scale number down by 10^3/10^6/10^9/10^12
 #define	xpfSUPPORT_SGR					1		// Set Graphics Rendition FG & BG colors only
 #define	xpfSUPPORT_URL					1		// URL encoding
+#define	xpfSUPPORT_FIXEDPOINT			1		// binary (Q) & decimal scaled integers
+#define	xpfSUPPORT_PROGRAMS				1		// precompiled & cached format programs
+#define	xpfSUPPORT_ASYNC				1		// asynchronous stdout pipeline, xPrintAsyncStart()
+#define	xpfSUPPORT_DEFERRED				1		// deferred (binary) capture, DPRINT() & DTRACK()
+#define	xpfSUPPORT_LOG_LEVELS			1		// runtime per module levels for LTRACK() & LPRINT()
+#define	xpfSUPPORT_RATE_LIMIT			1		// per call site rate limiting, RTRACK() & RPRINT()
+#define	xpfSUPPORT_ARRAYS				1		// "%[count sep]d" array modifier for numeric conversions
+#define	xpfSUPPORT_BATCH				1		// arrays of records (structures), xpcprintfx_batch()
+#define	xpfSUPPORT_HEXDUMP_MT			1		// multi threaded hexdump to buffer or file, Linux only
+#define	xpfSUPPORT_PACKED				1		// typed packed arguments, C++ front end printfx.hpp
+
+#if		(xpfSUPPORT_BATCH == 1) && (xpfSUPPORT_PROGRAMS == 0)
+	#error "xpfSUPPORT_BATCH requires xpfSUPPORT_PROGRAMS"
+#endif
+
+/* Levelled output, LTRACK(WARN, "x=%d", x) or LPRINT(INFO, ...) with level one of ERROR, WARN, INFO,
+ * DEBUG or VERBOSE. Levels above xpfLOG_LEVEL_MAX are removed by the preprocessor, arguments are not
+ * evaluated. Others are compared with the runtime level of the module (xpfLOG_MODULE, define it
+ * before including printfx.h) before any argument is evaluated, suppressed messages are counted
+ * per module, see xPrintLogLevel(), xPrintLogSuppressed() & vPrintLogReport() */
+#define	xpfLEVEL_NONE					0
+#define	xpfLEVEL_ERROR					1
+#define	xpfLEVEL_WARN					2
+#define	xpfLEVEL_INFO					3
+#define	xpfLEVEL_DEBUG					4
+#define	xpfLEVEL_VERBOSE				5
+
+#ifndef	xpfLOG_LEVEL_MAX
+	#define	xpfLOG_LEVEL_MAX			xpfLEVEL_VERBOSE	// compile time threshold
+#endif
+#ifndef	xpfLOG_LEVEL_DEFAULT
+	#define	xpfLOG_LEVEL_DEFAULT		xpfLEVEL_INFO		// initial runtime level, all modules
+#endif
+#ifndef	xpfLOG_MODULES
+	#define	xpfLOG_MODULES				16
+#endif
+#ifndef	xpfLOG_MODULE
+	#define	xpfLOG_MODULE				0					// module of the source file
+#endif
+
+#if		(xpfSUPPORT_LOG_LEVELS == 1)
+	extern uint8_t PrintLogLevel[xpfLOG_MODULES] ;
+	extern uint32_t PrintLogSuppressed[xpfLOG_MODULES] ;
+	#define	xpfLOG(L, OUT, f, ...)		do { if (PrintLogLevel[xpfLOG_MODULE] >= (L)) OUT(f, ##__VA_ARGS__) ;	\
+										else __atomic_fetch_add(&PrintLogSuppressed[xpfLOG_MODULE], 1, __ATOMIC_RELAXED) ; } while (0)
+#else
+	#define	xpfLOG(L, OUT, f, ...)		OUT(f, ##__VA_ARGS__)
+#endif
+#define	xpfLOG_OFF						do { } while (0)
+
+#if		(xpfLOG_LEVEL_MAX >= xpfLEVEL_ERROR)
+	#define	xpfLOG_ERROR(OUT, f, ...)	xpfLOG(xpfLEVEL_ERROR, OUT, f, ##__VA_ARGS__)
+#else
+	#define	xpfLOG_ERROR(OUT, f, ...)	xpfLOG_OFF
+#endif
+#if		(xpfLOG_LEVEL_MAX >= xpfLEVEL_WARN)
+	#define	xpfLOG_WARN(OUT, f, ...)	xpfLOG(xpfLEVEL_WARN, OUT, f, ##__VA_ARGS__)
+#else
+	#define	xpfLOG_WARN(OUT, f, ...)	xpfLOG_OFF
+#endif
+#if		(xpfLOG_LEVEL_MAX >= xpfLEVEL_INFO)
+	#define	xpfLOG_INFO(OUT, f, ...)	xpfLOG(xpfLEVEL_INFO, OUT, f, ##__VA_ARGS__)
+#else
+	#define	xpfLOG_INFO(OUT, f, ...)	xpfLOG_OFF
+#endif
+#if		(xpfLOG_LEVEL_MAX >= xpfLEVEL_DEBUG)
+	#define	xpfLOG_DEBUG(OUT, f, ...)	xpfLOG(xpfLEVEL_DEBUG, OUT, f, ##__VA_ARGS__)
+#else
+	#define	xpfLOG_DEBUG(OUT, f, ...)	xpfLOG_OFF
+#endif
+#if		(xpfLOG_LEVEL_MAX >= xpfLEVEL_VERBOSE)
+	#define	xpfLOG_VERBOSE(OUT, f, ...)	xpfLOG(xpfLEVEL_VERBOSE, OUT, f, ##__VA_ARGS__)
+#else
+	#define	xpfLOG_VERBOSE(OUT, f, ...)	xpfLOG_OFF
+#endif
+
+#define	LTRACK(L, f, ...)				xpfLOG_##L(TRACK, f, ##__VA_ARGS__)
+#define	LPRINT(L, f, ...)				xpfLOG_##L(PRINT, f, ##__VA_ARGS__)
+#define	LDTRACK(L, f, ...)				xpfLOG_##L(DTRACK, f, ##__VA_ARGS__)
+#define	LDPRINT(L, f, ...)				xpfLOG_##L(DPRINT, f, ##__VA_ARGS__)
+
+/* Rate limited output, each RTRACK() / RPRINT() call site allows a burst of xpfRATE_BURST messages
+ * and xpfRATE_PER_SEC sustained (token bucket, RunTime based). The check is done before any argument
+ * is evaluated, suppressed messages are counted & reported as "last message repeated N times"
+ * ahead of the next message passed by the same call site */
+#ifndef	xpfRATE_PER_SEC
+	#define	xpfRATE_PER_SEC				5
+#endif
+#ifndef	xpfRATE_BURST
+	#define	xpfRATE_BURST				10
+#endif
+
+#if		(xpfSUPPORT_RATE_LIMIT == 1)
+	#define	xpfRATE(OUT, f, ...)		do { static xprl_t sRL ;										\
+										uint32_t Pass = xPrintRateCheck(&sRL, xpfRATE_PER_SEC, xpfRATE_BURST) ;	\
+										if (Pass > 1) OUT("last message repeated %u times\n", Pass - 1) ;	\
+										if (Pass) OUT(f, ##__VA_ARGS__) ; } while (0)
+#else
+	#define	xpfRATE(OUT, f, ...)		OUT(f, ##__VA_ARGS__)
+#endif
+#define	RTRACK(f, ...)					xpfRATE(TRACK, f, ##__VA_ARGS__)
+#define	RPRINT(f, ...)					xpfRATE(PRINT, f, ##__VA_ARGS__)
 
 #define	xpfMAXIMUM_DECIMALS				15
+#define	xpfMAX_FIXED_DECIMALS			19			// (Qq) fraction digits held in uint64_t, 10^19 < 2^64
 #define	xpfDEFAULT_DECIMALS				6
 
 #define	xpfMAX_TIME_FRAC				6		// control resolution mS/uS/nS
@@ -75,6 +191,7 @@ extern unsigned long long RunTime ;
 
 #define xpfMAX_LEN_F32					(sizeof("+4,294,967,295.") + xpfMAXIMUM_DECIMALS)
 #define xpfMAX_LEN_F64					(sizeof("+18,446,744,073,709,551,615.") + xpfMAXIMUM_DECIMALS)
+#define xpfMAX_LEN_FIXED				(sizeof("+18,446,744,073,709,551,615.") + xpfMAX_FIXED_DECIMALS)
 
 #define	xpfMAX_LEN_B32					sizeof("1010-1010|1010-1010 1010-1010|1010-1010")
 #define	xpfMAX_LEN_B64					(xpfMAX_LEN_B32 * 2)
@@ -98,6 +215,7 @@ extern unsigned long long RunTime ;
  * ( 0x12345678 {32 x 3} [ 32 x Char]) = 142 plus some safety = 160 characters max.
  * When done in stages max size about 96 */
 #define	xpfHEXDUMP_WIDTH				32			// number of bytes (as bytes/short/word/llong) in a single row
+#define	xpfMAX_LEN_DUMP					(sizeof("0x12345678: ") + (xpfHEXDUMP_WIDTH * 4) + 2)
 
 /* Maximum size is determined by bit width of maxlen and curlen fields below */
 #define	xpfMAXLEN_BITS					16			// Number of bits in field(s)
@@ -170,14 +288,38 @@ typedef	struct __attribute__((packed)) xpf_t {
 		// byte 3
 			uint8_t		Pspc		: 1 ;
 			uint8_t		src			: 2 ;				// src?
-			uint8_t		spare		: 5 ;				// SPARE !!!
+			uint8_t		squeeze		: 1 ;				// '=' collapse identical HEXDUMP rows
+			uint8_t		stable		: 1 ;				// span valid until call returns, sink may reference
+			uint8_t		spare		: 3 ;				// SPARE !!!
 		} ;
 	} ;
 } xpf_t ;
 DUMB_STATIC_ASSERT(sizeof(xpf_t) == 12) ;
 
+/* Masks of the individual bits in xpf_t.flags, used by the table driven format parser to set
+ * modifier flags without a switch. MUST be kept in step with the bit field layout above which,
+ * with GCC on a little endian target, allocates from the LSB of each byte upwards. */
+#if		(__BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__)
+	#error "xpfFLAG_* masks assume little endian bit field allocation"
+#endif
+#define	xpfFLAG_GROUP					(1UL << 0)
+#define	xpfFLAG_ALT_FORM				(1UL << 1)
+#define	xpfFLAG_LJUST					(1UL << 2)
+#define	xpfFLAG_UCASE					(1UL << 3)
+#define	xpfFLAG_PAD0					(1UL << 4)
+#define	xpfFLAG_LLONG					(1UL << 5)
+#define	xpfFLAG_RADIX					(1UL << 6)
+#define	xpfFLAG_REL_VAL					(1UL << 7)
+#define	xpfFLAG_PLUS					(1UL << 19)
+#define	xpfFLAG_ARG_WIDTH				(1UL << 20)
+#define	xpfFLAG_ARG_PREC				(1UL << 21)
+#define	xpfFLAG_PSPC					(1UL << 24)
+#define	xpfFLAG_SQUEEZE					(1UL << 27)
+#define	xpfFLAG_NBASE(b)				((uint32_t) (b) << 8)	// nbase, 5 bits
+
 typedef	struct __attribute__((packed)) xpc_t {
-	int 	(*handler)(struct xpc_t * , int ) ;
+	int 	(*handler)(struct xpc_t * , int ) ;				// legacy single character sink
+	int		(*writer)(struct xpc_t * , const char * , size_t) ;	// span sink, returns # chars written
 	union {
 		void *			pVoid ;
 		char *			pStr ;							// string buffer
@@ -189,13 +331,201 @@ typedef	struct __attribute__((packed)) xpc_t {
 	} ;
 	xpf_t	f ;
 } xpc_t ;
-DUMB_STATIC_ASSERT(sizeof(xpc_t) == (12 + sizeof(int *) + sizeof(void *))) ;
+DUMB_STATIC_ASSERT(sizeof(xpc_t) == (12 + (2 * sizeof(int *)) + sizeof(void *))) ;
+
+/* Precompiled format program, literal spans & conversion templates with pre-decoded flags/limits
+ * Literal ops have cFmt == 0 and reference the format string directly, hence the format string
+ * MUST remain valid for as long as the program is used. The cache holds 2^xpfPROG_CACHE_BITS
+ * programs (~270 bytes each), a format uses the first free of xpfPROG_CACHE_PROBE slots from its
+ * hash. Size the cache from vPrintProgStats(), Misses counts calls parsed for lack of a slot. */
+#define	xpfPROG_MAX_OPS					16			// max literal spans + conversions per program
+#ifndef	xpfPROG_CACHE_BITS
+	#define	xpfPROG_CACHE_BITS			5
+#endif
+#define	xpfPROG_CACHE_SIZE				(1 << xpfPROG_CACHE_BITS)
+#define	xpfPROG_CACHE_PROBE				4			// slots tried per format, <= xpfPROG_CACHE_SIZE
+#define	xpfPROG_NONE					0xFF		// cached Count, format too complex to compile
+
+#define	xpoARG_WIDTH					0x01		// '*' field width supplied by argument
+#define	xpoARG_PRECIS					0x02		// '.*' precision supplied by argument
+#define	xpoARG_COUNT					0x04		// '[*' array element count supplied by argument
+#define	xpoARG_ARRAY					0x08		// '[' array modifier, pointer to elements supplied
+#define	xpoARR_SHIFT					4			// log2 of element size, if xpoARR_SIZED
+#define	xpoARR_MASK						0x30
+#define	xpoARR_SIZED					0x40		// element size specified [bhwl] else by conversion
+#define	xpoARR_INVALID					0x80		// not a numeric conversion or element size mismatch
+
+typedef	struct xpo_t {
+	union {
+		struct {
+			uint32_t	limits ;						// xpf_t limits (minwid & precis)
+			uint32_t	flags ;							// xpf_t flags
+		} ;
+		const char *	pcLit ;							// literal span start
+	} ;
+	uint16_t	Len ;									// literal span length
+	uint8_t		cFmt ;									// conversion character, 0 = literal
+	uint8_t		Args ;									// xpoARG_??? & xpoARR_??? flags
+	uint16_t	Count ;									// array elements, if not by argument
+	char		Sep[2] ;								// array element separator, NUL if none
+} xpo_t ;
+
+typedef	struct xpp_t {
+	const char *	pcFmt ;								// source format, cache key
+	uint8_t			Count ;
+	xpo_t			Ops[xpfPROG_MAX_OPS] ;
+} xpp_t ;
+
+typedef	struct xpcs_t {									// program cache counters
+	uint32_t	Hits ;									// cached program executed
+	uint32_t	Misses ;								// no free slot, parsed
+	uint16_t	Slots ;									// in use, incl formats too complex to compile
+	uint16_t	Size ;									// xpfPROG_CACHE_SIZE
+} xpcs_t ;
+
+/* Multi threaded hexdump (Linux), complete rows all have the same length so each thread formats a
+ * range of rows straight into its final position in the output buffer or mmap'd file */
+#define	xpfDUMP_THREADS_MAX				32
+#define	xpfDUMP_ROWS_MIN				128			// min rows per thread, fewer threads if less
+
+typedef	struct xpd_t {									// streaming hexdump context, see %Y
+	const char *	pcRow ;								// absolute address of held row
+	uint32_t		Offset ;							// relative offset of held row
+	uint8_t			Size ;								// xpfSIZING_BYTE/SHORT/WORD/DWORD
+	uint8_t			Fill ;								// bytes held in Row[]
+	uint8_t			Row[xpfHEXDUMP_WIDTH] ;				// incomplete row carried between chunks
+} xpd_t ;
+
+typedef	struct xpa_t {									// argument source
+	va_list			vArgs ;
+	const uint8_t *	pArgs ;								// captured arguments, NULL = use vArgs
+	uint8_t			Refs ;								// pArgs has pointers only, data NOT copied
+} xpa_t ;
+
+/* File descriptor output is staged and written with write/writev, string arguments & literals
+ * of at least xpfFD_IOV_MIN chars passed by reference (dprintfx only). MUST exceed the size of the
+ * padding buffer in vPrintRepeat() since that is output while a string argument is in progress */
+#define	xpfFD_BUF_SIZE					256
+#define	xpfFD_IOV_MAX					8
+#define	xpfFD_IOV_MIN					64
+
+/* Asynchronous stdout pipeline, ring of fixed size records drained by a dedicated task. A call
+ * producing more than xpfASYNC_REC_SIZE chars is NOT queued, it falls back to synchronous output
+ * under printfx_lock() (after draining the ring) hence waits for the UART like printfx() would.
+ * Size xpfASYNC_REC_SIZE for the longest line that must not block. */
+#define	xpfASYNC_RECORDS				16			// ring slots, MUST be a power of 2
+#define	xpfASYNC_REC_SIZE				128			// max chars per record, longer output synchronous
+#define	xpfASYNC_STACK					2048
+#define	xpfASYNC_PRIORITY				2
+
+enum { xpfASYNC_BLOCK, xpfASYNC_DROP, xpfASYNC_OVERWRITE } ;	// policy when the ring is full
+
+typedef	struct xpas_t {									// async pipeline counters
+	uint32_t	Records ;								// published
+	uint32_t	Dropped ;								// discarded, ring full (DROP)
+	uint32_t	Overwritten ;							// oldest discarded (OVERWRITE)
+	uint32_t	Blocked ;								// producer waits (BLOCK)
+} xpas_t ;
+
+/* Deferred capture, records of [xpdh_t][arguments] in a byte ring. Arguments are packed, unaligned,
+ * in format order, value as passed. Pointers to data (%s %U %m %B %H %W %Y %D %T %Z) are followed by
+ * a U16 length & a copy of the data (strings include the terminator), blocks truncated to fit.
+ * A %s pointer that is NULL or invalid has length 0, a %Y context pointer is followed by the U8
+ * value size. Records read by xPrintDeferredRead() keep this layout, see printfx_decode.c */
+#define	xpfDEFER_BUF_SIZE				4096		// ring size, MUST be a power of 2
+#define	xpfDEFER_REC_MAX				256			// max record size, incl header
+#define	xpfDEFER_ALIGN					sizeof(uintptr_t)
+
+enum { xpfDEFER_REC = 1, xpfDEFER_PAD } ;				// record types
+
+typedef	struct xpdh_t {									// deferred record header
+	uint32_t		Hdr ;								// Len (incl header) | Type << 16, 0 = not published
+	const char *	pcFmt ;
+} xpdh_t ;
+
+typedef	struct xpds_t {									// deferred capture counters
+	uint32_t	Records ;								// output by xPrintDeferredDrain()
+	uint32_t	Dropped ;								// discarded, ring full
+	uint32_t	Truncated ;								// data blocks shortened to fit
+} xpds_t ;
+
+/* Socket output is staged on the caller's stack and sent each time the buffer fills, all but the
+ * last chunk with MSG_MORE so the TCP stack coalesces them into MSS sized segments. Kept small to
+ * limit stack use, define as CONFIG_LWIP_TCP_MSS to send whole segments per xNetWrite() */
+#ifndef	xpfSOCK_BUF_SIZE
+	#define	xpfSOCK_BUF_SIZE			256
+#endif
+
+typedef	struct xprl_t {									// rate limited call site, zero initialised
+	uint32_t	TAT ;									// theoretical arrival time, RunTime >> 10
+	uint32_t	Suppressed ;							// since the last message passed
+} xprl_t ;
+
+typedef	struct xpfb_t {									// buffered file descriptor sink
+	int			fd ;
+	uint16_t	Used ;
+	char		Buf[xpfFD_BUF_SIZE] ;
+} xpfb_t ;
+
+/* Batch output, every record of an array of structures formatted by the same format which is
+ * compiled ONCE per call. Each conversion takes its value from the next field descriptor, not from
+ * arguments. Supported are d i u o x J e f g c s p I & arrays with a fixed count, NOT '*' width,
+ * precision or count. Sinks with a limit (string) receive complete records only, Next is left at
+ * the first record that did not fit. Ranges [Next, Count) of the same array can be formatted by
+ * different tasks into their own buffers and output in sequence. */
+enum {													// record field types
+	xpfFIELD_I8, xpfFIELD_U8, xpfFIELD_I16, xpfFIELD_U16, xpfFIELD_I32, xpfFIELD_U32,
+	xpfFIELD_I64, xpfFIELD_U64, xpfFIELD_F32, xpfFIELD_F64,
+	xpfFIELD_PTR,										// pointer stored in the field, %s or %p
+	xpfFIELD_REF,										// address of the field, inline char[] or array
+} ;
+
+#define	xpfFIELD(T, M, F)				{ .Offset = __builtin_offsetof(T, M), .Type = xpfFIELD_##F }
+
+typedef	struct xpbf_t {									// record field descriptor
+	uint16_t	Offset ;								// of the field in the record
+	uint8_t		Type ;									// xpfFIELD_???
+} xpbf_t ;
+
+typedef	struct xpb_t {									// batch of records
+	const void *	pvBase ;							// first record of the array
+	const xpbf_t *	psField ;							// one per conversion, in format order
+	uint32_t		Stride ;							// record size, sizeof(T)
+	uint32_t		Next ;								// next record to output, updated
+	uint32_t		Count ;								// end of range, records in the array
+	uint8_t			Fields ;							// number of descriptors
+} xpb_t ;
 
 // ################################### Public functions ############################################
 
 int		xpcprintfx(xpc_t * psXPC, const char * format, va_list vArgs) ;
 
 int		xprintfx(int (handler)(xpc_t *, int), void *, size_t, const char *, va_list) ;
+int		xprintfx_span(int (writer)(xpc_t *, const char *, size_t), void *, size_t, const char *, va_list) ;
+
+int		xPrintCompile(xpp_t * psProg, const char * format) ;
+const xpp_t * psPrintProgFind(const char * format) ;
+void	vPrintProgStats(xpcs_t * psStats) ;
+int		xpcprintfx_prog(xpc_t * psXPC, const xpp_t * psProg, va_list vArgs) ;
+int		xpcprintfx_cached(xpc_t * psXPC, const char * format, va_list vArgs) ;
+int		xpcprintfx_record(xpc_t * psXPC, const char * format, const void * pArgs) ;
+int		xpcprintfx_record_prog(xpc_t * psXPC, const xpp_t * psProg, const char * format, const void * pArgs) ;
+int		xpcprintfx_packed(xpc_t * psXPC, const char * format, const void * pArgs) ;
+int		xpcprintfx_batch(xpc_t * psXPC, const char * format, xpb_t * psBatch) ;
+
+const char * pcPrintNextSpec(const char * pStr) ;
+const char * pcPrintParseSpec(xpo_t * psOp, const char * format) ;
+
+// Conversion engine, used directly by the compile time programs in printfx.hpp
+void	vPrintSpanRef(xpc_t * psXPC, const char * pStr, int Len) ;
+void	vPrintConvert(xpc_t * psXPC, int cFmt, xpa_t * psArgs) ;
+void	vPrintOp(xpc_t * psXPC, const xpo_t * psOp, xpa_t * psArgs) ;
+
+void	vPrintDumpInit(xpd_t * psXPD, int Size) ;
+#if		(xpfSUPPORT_HEXDUMP == 1) && (xpfSUPPORT_HEXDUMP_MT == 1) && defined(__linux__)
+int64_t	xPrintHexDumpMT(char * pBuf, size_t Size, const char * pcSpec, const void * pvSrc, size_t Len, int Threads) ;
+int64_t	xPrintHexDumpFile(int fd, const char * pcSpec, const void * pvSrc, size_t Len, int Threads) ;
+#endif
 
 /* Public function prototypes for extended functionality version of stdio supplied functions
  * These names MUST be used if any of the extended functionality is used in a format string */
@@ -206,6 +536,11 @@ int 	vsnprintfx(char * , size_t , const char * , va_list ) ;
 int 	snprintfx(char * , size_t , const char * , ...) ;
 int 	vsprintfx(char * , const char * , va_list ) ;
 int		sprintfx(char * , const char * , ...) ;
+int 	vsnprintfx_cached(char * , size_t , const char * , va_list ) ;
+int 	snprintfx_cached(char * , size_t , const char * , ...) ;
+int		snprintfx_batch(char * , size_t , const char * , xpb_t * ) ;
+int		snprintfx_packed(char * , size_t , const char * , const void * ) ;
+int		xPrintToStringSpan(xpc_t * , const char * , size_t ) ;
 
 // ##################################### Destination = STDOUT ######################################
 
@@ -216,9 +551,30 @@ int 	vnprintfx(size_t, const char *, va_list) ;
 int 	vprintfx(const char * , va_list) ;
 int 	nprintfx(size_t, const char *, ...) ;
 int		printfx(const char *, ...) ;
+int 	vprintfx_cached(const char * , va_list) ;
+int		printfx_cached(const char *, ...) ;
+int		printfx_batch(const char *, xpb_t *) ;
+int		printfx_span(const char *, size_t) ;
+int		printfx_packed(const char *, const void *) ;
 
 int 	vnprintfx_nolock(size_t count, const char * format, va_list vArgs) ;
 int 	printfx_nolock(const char * format, ...) ;
+int		printfx_span_nolock(const char *, size_t) ;
+
+int		xPrintAsyncStart(int Policy) ;
+void	vPrintAsyncStats(xpas_t * psStats) ;
+
+void	vPrintDeferredV(const char * format, va_list vArgs) ;
+void	vPrintDeferred(const char * format, ...) ;
+int		xPrintDeferredDrain(FILE * stream, int Max) ;
+int		xPrintDeferredRead(void * pBuf, size_t Size) ;
+void	vPrintDeferredStats(xpds_t * psStats) ;
+
+int		xPrintLogLevel(int Module, int Level) ;
+uint32_t xPrintLogSuppressed(int Module, int Reset) ;
+void	vPrintLogReport(void) ;
+
+uint32_t xPrintRateCheck(xprl_t * psRL, uint32_t Rate, uint32_t Burst) ;
 
 // ############################## LOW LEVEL DIRECT formatted output ################################
 
@@ -231,12 +587,22 @@ int		wsnprintfx(char ** ppcBuf, size_t * pSize, const char * pcFormat, ...) ;
 
 int		vfprintfx(FILE * , const char * , va_list ) ;
 int		fprintfx(FILE * , const char * , ...) ;
+int		fprintfx_packed(FILE * , const char * , const void * ) ;
+int		fprintfx_span(FILE * , const char * , size_t ) ;
 
 // ################################### Destination = HANDLE ########################################
 
 int		vdprintfx(int , const char *, va_list ) ;
 int		dprintfx(int , const char *, ...) ;
 
+void	vPrintFdInit(xpfb_t *, int) ;
+int		xPrintFdFlush(xpfb_t *) ;
+int		vbdprintfx(xpfb_t *, const char *, va_list ) ;
+int		bdprintfx(xpfb_t *, const char *, ...) ;
+int		dprintfx_batch(int , const char *, xpb_t *) ;
+int		dprintfx_packed(int , const char *, const void *) ;
+int		dprintfx_span(int , const char *, size_t) ;
+
 // ################################### Destination = DEVICE ########################################
 
 int 	vdevprintfx(int (* handler)(int ), const char *, va_list) ;
@@ -246,6 +612,7 @@ int 	devprintfx(int (* handler)(int), const char *, ...) ;
 
 int 	vsocprintfx(struct netx_t *, const char *, va_list) ;
 int 	socprintfx(struct netx_t *, const char *, ...) ;
+int		socprintfx_batch(struct netx_t *, const char *, xpb_t *) ;
 
 // #################################### Destination : UBUF #########################################
 
@@ -254,6 +621,10 @@ int     uprintfx(struct ubuf_t *, const char * , ...) ;
 
 // ##################################### functional tests ##########################################
 
+void	vPrintfUnitTest(void) ;
+void	vPrintfCxxTest(void) ;								// printfx_tests.cpp, printfx_tests_cxx target
+void	vPrintfBenchmark(void) ;
+
 #ifdef __cplusplus
 }
 #endif
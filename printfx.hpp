@@ -0,0 +1,775 @@
+/*
+ * Copyright 2014-21 Andre M. Maree / KSS Technologies (Pty) Ltd.
+ *
+ *	printfx.hpp - type safe C++ front end, header only, C++20
+ */
+
+#pragma once
+
+#include	"printfx.h"
+
+#include	<cstddef>
+#include	<cstdint>
+#include	<cstring>
+#include	<utility>
+#include	<type_traits>
+
+#if		(__cplusplus < 202002L)
+	#error "printfx.hpp requires C++20 (consteval)"
+#endif
+
+#if		(xpfSUPPORT_PACKED == 0)
+	#error "printfx.hpp requires xpfSUPPORT_PACKED"
+#endif
+
+/* printfx::print(sink, "format", args...)
+ * The format (MUST be a string literal) is parsed at compile time exactly as pcPrintParseSpec()
+ * does at run time. Each argument is checked against the conversion, '*' or '[*' consuming it, in
+ * sequence, a mismatch or wrong number of arguments fails to compile with a call to one of the
+ * xpf::error_???() functions below. Arguments are then packed, each converted to exactly what the
+ * conversion fetches, and formatted by xpcprintfx_packed(), no va_list or default promotions.
+ * The length of a dump (%B %H %W %Y) is any integer, sizeof() or size_t included, narrowed to int.
+ * Sinks:	printfx::out						stdout, async pipeline if started
+ * 			char (&)[N] / printfx::buffer{p, n}	string, terminated as for snprintfx()
+ * 			FILE *								stream, locked once
+ * 			int									file descriptor, staged as for dprintfx()
+ * 			xpc_t *								any writer, caller initialised
+ *
+ * printfx::emit<"format">(sink, args...)
+ * As above with the format a template argument, compiled at compile time into a fixed sequence of
+ * vPrintSpanRef() / vPrintConvert() calls with the xpf_t flags & limits of each conversion as constants.
+ * printfx::bound<"format"> is the longest possible output, printfx::bufsize<"format"> a buffer for it.
+ *
+ * printfx is a struct, not a namespace, since printfx() the C function has the same name. The name
+ * before '::' is looked up as a type or namespace only hence printfx::print() resolves as expected.
+ */
+
+namespace xpf {
+
+// Compile time diagnostics, never defined, calling one during constant evaluation fails the build
+void	error_invalid_format() ;
+void	error_unsupported_conversion() ;
+void	error_too_few_arguments() ;
+void	error_too_many_arguments() ;
+void	error_integer_expected() ;
+void	error_integer_too_wide_use_ll() ;
+void	error_floating_point_expected() ;
+void	error_string_expected() ;
+void	error_pointer_expected() ;
+void	error_byte_pointer_expected() ;
+void	error_TSZ_t_pointer_expected() ;
+void	error_xpd_t_pointer_expected() ;
+void	error_array_element_type_mismatch() ;
+void	error_dump_width_from_argument() ;
+void	error_dump_length_expected() ;
+void	error_width_out_of_range() ;
+void	error_output_unbounded() ;
+
+enum : uint8_t { xpkI32, xpkI64, xpkF64, xpkPTR } ;		// packed argument kinds
+enum : uint8_t { xptOTHER, xptINT, xptFLOAT, xptPTR, xptNULL } ;	// argument type classes
+enum : uint8_t { xprNONE, xprVOID, xprCHAR, xprINT, xprFLOAT, xprTSZ, xprXPD, xprOTHER } ;	// pointee classes
+
+typedef	struct xpt_t {									// argument type, as seen by the checker
+	uint8_t		Cls ;									// xpt???
+	uint8_t		Size ;
+	uint8_t		Ref ;									// xpr???, pointers only
+	uint8_t		RefSize ;
+	bool		RefConst ;
+} xpt_t ;
+
+template <typename T>
+consteval xpt_t xTypeInfo() {
+	using D = std::decay_t<T> ;
+	if constexpr (std::is_null_pointer_v<D>) {
+		return { xptNULL, sizeof(D), xprNONE, 0, false } ;
+	} else if constexpr (std::is_integral_v<D> || std::is_enum_v<D>) {
+		return { xptINT, sizeof(D), xprNONE, 0, false } ;
+	} else if constexpr (std::is_floating_point_v<D>) {
+		return { xptFLOAT, sizeof(D), xprNONE, 0, false } ;
+	} else if constexpr (std::is_pointer_v<D> && !std::is_function_v<std::remove_pointer_t<D>>) {
+		using P = std::remove_pointer_t<D> ;
+		using U = std::remove_cv_t<P> ;
+		constexpr bool Const = std::is_const_v<P> ;
+		if constexpr (std::is_void_v<U>) {
+			return { xptPTR, sizeof(D), xprVOID, 0, Const } ;
+		} else if constexpr (std::is_same_v<U, char> || std::is_same_v<U, signed char> ||
+							std::is_same_v<U, unsigned char> || std::is_same_v<U, char8_t>) {
+			return { xptPTR, sizeof(D), xprCHAR, 1, Const } ;
+		} else if constexpr (std::is_integral_v<U> || std::is_enum_v<U>) {
+			return { xptPTR, sizeof(D), xprINT, sizeof(U), Const } ;
+		} else if constexpr (std::is_floating_point_v<U>) {
+			return { xptPTR, sizeof(D), xprFLOAT, sizeof(U), Const } ;
+		} else if constexpr (std::is_same_v<U, xpd_t>) {
+			return { xptPTR, sizeof(D), xprXPD, sizeof(U), Const } ;
+		} else if constexpr (requires (U & R) { R.usecs ; R.pTZ ; }) {	// TSZ_t, header not required
+			return { xptPTR, sizeof(D), xprTSZ, sizeof(U), Const } ;
+		} else {
+			return { xptPTR, sizeof(D), xprOTHER, 0, Const } ;
+		}
+	} else {
+		return { xptOTHER, sizeof(D), xprNONE, 0, false } ;
+	}
+}
+
+constexpr bool bPrintIsDigit(char cChr) { return cChr >= '0' && cChr <= '9' ; }
+
+// Pointer argument validation, NULL accepted where the conversion handles it
+constexpr bool bPrintAnyPtr(const xpt_t & sT) { return sT.Cls == xptPTR || sT.Cls == xptNULL ; }
+constexpr bool bPrintString(const xpt_t & sT) { return sT.Cls == xptNULL || (sT.Cls == xptPTR && sT.Ref == xprCHAR) ; }
+constexpr bool bPrintBytes(const xpt_t & sT) {
+	return sT.Cls == xptNULL || (sT.Cls == xptPTR &&
+		(sT.Ref == xprVOID || sT.Ref == xprCHAR || (sT.Ref == xprINT && sT.RefSize == 1))) ;
+}
+constexpr bool bPrintTSZ(const xpt_t & sT) { return sT.Cls == xptNULL || (sT.Cls == xptPTR && sT.Ref == xprTSZ) ; }
+constexpr bool bPrintXPD(const xpt_t & sT) { return sT.Cls == xptPTR && sT.Ref == xprXPD && !sT.RefConst ; }
+
+constexpr uint32_t xPrintModFlag(char cChr) {			// as sPrintModFlag[], 0 if not a modifier
+	switch (cChr) {
+	case '!':	return xpfFLAG_REL_VAL ;
+	case '#':	return xpfFLAG_ALT_FORM ;
+	case '\'':	return xpfFLAG_GROUP ;
+	case '*':	return xpfFLAG_ARG_WIDTH ;
+	case '+':	return xpfFLAG_PLUS ;
+	case '-':	return xpfFLAG_LJUST ;
+	case ' ':	return xpfFLAG_PSPC ;
+	case '0':	return xpfFLAG_PAD0 ;
+	case '=':	return xpfFLAG_SQUEEZE ;
+	default:	return 0 ;
+	}
+}
+
+/**
+ * pcPrintCompileSpec()
+ * \brief	compile time pcPrintParseSpec(), the same conversion template with flags & limits words
+ * 			bit for bit as the run time parser builds them. The only compile time parser, used by
+ * 			xPrintCheckArgs() & xPrintCompileFormat(), specs pcPrintParseSpec() asserts on fail here
+ * \param	sOp - instruction to be initialised
+ * 			fmt - pointer to the first character following the '%'
+ * \return	pointer to the conversion character or '%' if literal
+ */
+constexpr const char * pcPrintCompileSpec(xpo_t & sOp, const char * fmt) {
+	uint32_t	Flags = xpfFLAG_NBASE(BASE10) ;
+	uint32_t	MinWid = 0, Precis = 0 ;
+	if (xpfSUPPORT_ARRAYS && *fmt == '[') {				// as pcPrintParseArray()
+		sOp.Args |= xpoARG_ARRAY ;
+		if (*++fmt == '*') {
+			sOp.Args |= xpoARG_COUNT ;
+			++fmt ;
+		} else {
+			while (bPrintIsDigit(*fmt)) sOp.Count = (sOp.Count * 10) + (*fmt++ - '0') ;
+		}
+		if (*fmt == 'b' || *fmt == 'h' || *fmt == 'w' || *fmt == 'l') {
+			sOp.Args |= xpoARR_SIZED | (((*fmt == 'b') ? 0 : (*fmt == 'h') ? 1 : (*fmt == 'w') ? 2 : 3) << xpoARR_SHIFT) ;
+			++fmt ;
+		}
+		for (size_t Idx = 0; *fmt && *fmt != ']'; ++fmt) {
+			if (Idx < sizeof(sOp.Sep)) sOp.Sep[Idx++] = *fmt ;
+		}
+		if (*fmt != ']') error_invalid_format() ;
+		++fmt ;
+	}
+	while (*fmt == '%' || xPrintModFlag(*fmt)) {
+		if (*fmt == '%') {								// '%' literal to display
+			sOp.cFmt	= 0 ;
+			sOp.pcLit	= fmt ;
+			sOp.Len		= 1 ;
+			return fmt ;
+		}
+		if (*fmt == '*' && (sOp.Args & xpoARG_WIDTH)) error_invalid_format() ;
+		Flags	|= xPrintModFlag(*fmt) ;
+		sOp.Args |= (*fmt == '*') ? xpoARG_WIDTH : 0 ;
+		++fmt ;
+	}
+	if (*fmt == '.' || bPrintIsDigit(*fmt)) {
+		uint32_t Siz = 0 ;
+		while (1) {
+			if (bPrintIsDigit(*fmt)) {
+				Siz = (Siz * 10) + (*fmt++ - '0') ;
+				if (Siz > xpfMINWID_MAXVAL) error_width_out_of_range() ;
+			} else if (*fmt == '.') {
+				if (Flags & xpfFLAG_RADIX) error_invalid_format() ;
+				++fmt ;
+				Flags |= xpfFLAG_RADIX ;
+				if (Siz > 0) {
+					if (Flags & xpfFLAG_ARG_WIDTH) error_invalid_format() ;
+					MinWid = Siz ;
+					Flags |= xpfFLAG_ARG_WIDTH ;
+					Siz = 0 ;
+				}
+			} else if (*fmt == '*') {
+				if (!(Flags & xpfFLAG_RADIX) || Siz > 0 || (sOp.Args & xpoARG_PRECIS)) error_invalid_format() ;
+				++fmt ;
+				sOp.Args |= xpoARG_PRECIS ;
+				Flags |= xpfFLAG_ARG_PREC ;
+				Siz = 0 ;
+			} else {
+				break ;
+			}
+		}
+		if (Siz > 0) {
+			if ((Flags & (xpfFLAG_ARG_WIDTH | xpfFLAG_RADIX)) == 0) {
+				MinWid = Siz ;
+				Flags |= xpfFLAG_ARG_WIDTH ;
+			} else if ((Flags & (xpfFLAG_ARG_PREC | xpfFLAG_RADIX)) == xpfFLAG_RADIX) {
+				Precis = Siz ;
+				Flags |= xpfFLAG_ARG_PREC ;
+			} else {
+				error_invalid_format() ;
+			}
+		}
+	}
+	if (fmt[0] == 'l' && fmt[1] == 'l') {
+		fmt += 2 ;
+		Flags |= xpfFLAG_LLONG ;
+	}
+	char cFmt = *fmt ;
+	if (cFmt == 'X' || (cFmt == 'M' && xpfSUPPORT_MAC_ADDR) || (cFmt == 'P' && xpfSUPPORT_POINTER) ||
+		((cFmt == 'A' || cFmt == 'E' || cFmt == 'G') && xpfSUPPORT_IEEE754)) {
+		cFmt |= 0x20 ;
+		Flags |= xpfFLAG_UCASE ;
+	}
+	if (cFmt == 0) error_invalid_format() ;
+	sOp.cFmt	= cFmt ;
+	sOp.limits	= MinWid | (Precis << xpfMINWID_BITS) ;
+	sOp.flags	= Flags ;
+	return fmt ;
+}
+
+/**
+ * xPrintCheckArgs()
+ * \brief	walk the format consuming the argument types in the same sequence as vPrintOp() and
+ * 			vPrintConvert() fetch them, fails to compile on any mismatch
+ * \param	fmt - format string
+ * 			pKind - one xpk??? per argument, how it is to be packed
+ */
+template <typename... Types>
+consteval void xPrintCheckArgs(const char * fmt, uint8_t * pKind) {
+	const xpt_t	sType[] = { xTypeInfo<Types>()..., xpt_t { } } ;
+	size_t	Idx = 0 ;
+	auto	Next = [&]() -> const xpt_t & {
+		if (Idx == sizeof...(Types)) error_too_few_arguments() ;
+		return sType[Idx] ;
+	} ;
+	auto	Int = [&](bool Wide) {
+		const xpt_t & sT = Next() ;
+		if (sT.Cls != xptINT) error_integer_expected() ;
+		if (!Wide && sT.Size > sizeof(int32_t)) error_integer_too_wide_use_ll() ;
+		pKind[Idx++] = Wide ? xpkI64 : xpkI32 ;
+	} ;
+	auto	Len = [&]() {									// dump length, size_t/sizeof narrowed to int
+		if (Next().Cls != xptINT) error_dump_length_expected() ;
+		pKind[Idx++] = xpkI32 ;
+	} ;
+	auto	Flt = [&]() {
+		if (Next().Cls != xptFLOAT) error_floating_point_expected() ;
+		pKind[Idx++] = xpkF64 ;
+	} ;
+	auto	Ptr = [&](bool (* Valid)(const xpt_t &), void (* Error)()) {
+		if (!Valid(Next())) Error() ;
+		pKind[Idx++] = xpkPTR ;
+	} ;
+	while (*fmt) {
+		if (*fmt++ != '%') continue ;
+		xpo_t	sOp { } ;
+		fmt = pcPrintCompileSpec(sOp, fmt) + 1 ;		// never at the NUL, error_invalid_format()
+		if (sOp.cFmt == 0) continue ;					// "%%"
+		const char	cFmt = sOp.cFmt ;
+		const bool	LLong = sOp.flags & xpfFLAG_LLONG ;
+		if (sOp.Args & xpoARG_COUNT) Int(false) ;
+		if (sOp.Args & xpoARG_WIDTH) Int(false) ;
+		if (sOp.Args & xpoARG_PRECIS) Int(false) ;
+		bool Float = (cFmt == 'e' || cFmt == 'f' || cFmt == 'g' || cFmt == 'a') ;
+		if (Float && xpfSUPPORT_IEEE754 == 0) error_unsupported_conversion() ;
+		if (sOp.Args & xpoARG_ARRAY) {
+			if (!Float && cFmt != 'd' && cFmt != 'i' && cFmt != 'o' && cFmt != 'x' &&
+				cFmt != 'u' && !(cFmt == 'J' && xpfSUPPORT_BINARY))
+				error_unsupported_conversion() ;
+			int Size = (sOp.Args & xpoARR_SIZED) ? 1 << ((sOp.Args & xpoARR_MASK) >> xpoARR_SHIFT) : Float ? sizeof(double) : LLong ? sizeof(uint64_t) : sizeof(uint32_t) ;
+			if (Float && Size < (int) sizeof(float)) error_array_element_type_mismatch() ;
+			const xpt_t & sT = Next() ;
+			if (sT.Cls == xptPTR && sT.Ref != xprVOID) {
+				bool Elem = Float ? (sT.Ref == xprFLOAT) : (sT.Ref == xprINT || sT.Ref == xprCHAR) ;
+				if (!Elem || sT.RefSize != Size) error_array_element_type_mismatch() ;
+			} else if (sT.Cls != xptPTR && sT.Cls != xptNULL) {
+				error_pointer_expected() ;
+			}
+			pKind[Idx++] = xpkPTR ;
+			continue ;
+		}
+		bool Dump = (cFmt == 'B' || cFmt == 'H' || cFmt == 'W' || cFmt == 'Y') ;
+		if (Dump && (sOp.Args & (xpoARG_WIDTH | xpoARG_PRECIS))) error_dump_width_from_argument() ;
+		switch (cFmt) {
+		case 'C':	if (xpfSUPPORT_SGR == 0) error_unsupported_conversion() ;		Int(false) ;	break ;
+		case 'I':	if (xpfSUPPORT_IP_ADDR == 0) error_unsupported_conversion() ;	Int(false) ;	break ;
+		case 'J':	if (xpfSUPPORT_BINARY == 0) error_unsupported_conversion() ;	Int(LLong) ;	break ;
+		case 'D':
+		case 'T':
+		case 'Z':	if (xpfSUPPORT_DATETIME == 0) error_unsupported_conversion() ;
+					Ptr(bPrintTSZ, error_TSZ_t_pointer_expected) ;
+					break ;
+		case 'R':	if (xpfSUPPORT_DATETIME == 0) error_unsupported_conversion() ;	Int(true) ;		break ;
+		case 'r':	if (xpfSUPPORT_DATETIME == 0) error_unsupported_conversion() ;	Int(false) ;	break ;
+		case 'U':	if (xpfSUPPORT_URL == 0) error_unsupported_conversion() ;
+					Ptr(bPrintString, error_string_expected) ;
+					break ;
+		case 'B':
+		case 'H':
+		case 'W':	if (xpfSUPPORT_HEXDUMP == 0) error_unsupported_conversion() ;
+					Len() ;
+					Ptr(bPrintAnyPtr, error_pointer_expected) ;
+					break ;
+		case 'Y':	if (xpfSUPPORT_HEXDUMP == 0) error_unsupported_conversion() ;
+					Ptr(bPrintXPD, error_xpd_t_pointer_expected) ;
+					Len() ;
+					Ptr(bPrintAnyPtr, error_pointer_expected) ;
+					break ;
+		case 'm':	if (xpfSUPPORT_MAC_ADDR == 0) error_unsupported_conversion() ;
+					Ptr(bPrintBytes, error_byte_pointer_expected) ;
+					break ;
+		case 'c':	Int(false) ;					break ;
+		case 'd':
+		case 'i':
+		case 'o':
+		case 'x':
+		case 'u':	Int(LLong) ;					break ;
+		case 'Q':
+		case 'q':	if (xpfSUPPORT_FIXEDPOINT == 0) error_unsupported_conversion() ;
+					Int(false) ;
+					Int(LLong) ;
+					break ;
+		case 'e':
+		case 'f':
+		case 'g':
+		case 'a':	Flt() ;							break ;
+		case 'p':	if (xpfSUPPORT_POINTER == 0) error_unsupported_conversion() ;
+					Ptr(bPrintAnyPtr, error_pointer_expected) ;
+					break ;
+		case 's':	Ptr(bPrintString, error_string_expected) ;	break ;
+		default:	error_unsupported_conversion() ;
+		}
+	}
+	if (Idx != sizeof...(Types)) error_too_many_arguments() ;
+}
+
+/**
+ * xpfs_t - format string checked against the argument types, constructed at compile time only
+ */
+template <typename... Args>
+struct xpfs_t {
+	template <size_t N>
+	consteval xpfs_t(const char (& fmt)[N]) : pcFmt(fmt), Kind { } { xPrintCheckArgs<Args...>(fmt, Kind) ; }
+	const char *	pcFmt ;
+	uint8_t			Kind[sizeof...(Args) + 1] ;			// xpk??? per argument
+} ;
+
+static_assert(sizeof(void *) <= sizeof(uint64_t)) ;
+constexpr size_t xpfPACK_MAX = sizeof(uint64_t) ;		// largest packed argument
+
+template <typename T>
+inline uint8_t * pPrintPack(uint8_t * pNow, uint8_t Kind, const T & Val) {
+	using D = std::decay_t<T> ;
+	if constexpr (std::is_pointer_v<D> || std::is_null_pointer_v<D>) {
+		const void * pV = (const void *) Val ;
+		memcpy(pNow, &pV, sizeof(pV)) ;
+		return pNow + sizeof(pV) ;
+	} else if constexpr (std::is_floating_point_v<D>) {
+		double F64 = Val ;
+		memcpy(pNow, &F64, sizeof(F64)) ;
+		return pNow + sizeof(F64) ;
+	} else if (Kind == xpkI64) {						// integral or enum, signed values sign extended
+		int64_t I64 = static_cast<int64_t>(Val) ;
+		memcpy(pNow, &I64, sizeof(I64)) ;
+		return pNow + sizeof(I64) ;
+	} else {
+		int32_t I32 = static_cast<int32_t>(Val) ;
+		memcpy(pNow, &I32, sizeof(I32)) ;
+		return pNow + sizeof(I32) ;
+	}
+}
+
+template <typename... Args>
+inline uint8_t * pPrintPackArgs(uint8_t * pBuf, const uint8_t * pKind, const Args &... args) {
+	((pBuf = pPrintPack(pBuf, *pKind++, args)), ...) ;
+	return pBuf ;
+}
+
+// ############################ Compile time programs, see printfx::emit ############################
+
+/**
+ * xpfc_t - format string as a template argument, the program & bound are computed once per format
+ */
+template <size_t N>
+struct xpfc_t {
+	consteval xpfc_t(const char (& fmt)[N]) { for (size_t Idx = 0; Idx < N; ++Idx) Str[Idx] = fmt[Idx] ; }
+	char	Str[N] ;
+} ;
+
+template <size_t N>
+struct xpfl_t {											// compiled program, N ops at most
+	size_t	Count ;
+	xpo_t	Ops[N ? N : 1] ;
+} ;
+
+constexpr size_t xpfUNBOUNDED = SIZE_MAX ;				// output length depends on argument values
+constexpr size_t xpfEMIT_STACK = 256 ;					// largest bound rendered on the stack
+
+/**
+ * xPrintCompileFormat()
+ * \brief	compile time xPrintCompile(), adjacent literals merged, no limit on the number of ops
+ * \param	fmt - format string, in the template parameter object hence literals referenced in place
+ * \return	program, at most N ops
+ */
+template <size_t N>
+constexpr xpfl_t<N> xPrintCompileFormat(const char * fmt) {
+	xpfl_t<N>	sP { } ;
+	while (*fmt != 0) {
+		xpo_t & sOp = sP.Ops[sP.Count] ;
+		if (*fmt == '%') {
+			fmt = pcPrintCompileSpec(sOp, fmt + 1) ;
+			if (*fmt != 0) ++fmt ;
+		} else {
+			const char * pEnd = fmt + 1 ;
+			while (*pEnd && *pEnd != '%') ++pEnd ;
+			sOp.cFmt	= 0 ;
+			sOp.pcLit	= fmt ;
+			sOp.Len		= (pEnd - fmt) > UINT16_MAX ? UINT16_MAX : pEnd - fmt ;
+			fmt += sOp.Len ;
+		}
+		if (sOp.cFmt == 0 && sP.Count) {				// literal, merge with adjacent literal ?
+			xpo_t & sPrv = sP.Ops[sP.Count - 1] ;
+			if (sPrv.cFmt == 0 && (sPrv.pcLit + sPrv.Len) == sOp.pcLit && (sPrv.Len + sOp.Len) <= UINT16_MAX) {
+				sPrv.Len += sOp.Len ;
+				sOp = xpo_t { } ;
+				continue ;
+			}
+		}
+		++sP.Count ;
+	}
+	return sP ;
+}
+
+template <size_t Count, size_t N>
+constexpr xpfl_t<Count> xPrintCompileTrim(const xpfl_t<N> & sP) {
+	xpfl_t<Count>	sT { } ;
+	sT.Count = Count ;
+	for (size_t Idx = 0; Idx < Count; ++Idx) sT.Ops[Idx] = sP.Ops[Idx] ;
+	return sT ;
+}
+
+constexpr size_t xPrintBoundAdd(size_t A, size_t B) { return (A == xpfUNBOUNDED || B == xpfUNBOUNDED) ? xpfUNBOUNDED : A + B ; }
+constexpr size_t xPrintBoundMax(size_t A, size_t B) { return A > B ? A : B ; }
+constexpr size_t xPrintGroups(size_t Digits, uint32_t Flags) { return (Flags & xpfFLAG_GROUP) ? (Digits - 1) / 3 : 0 ; }
+
+/**
+ * xPrintValueBound()
+ * \brief	longest output of a numeric conversion, single value or array element
+ * \param	sOp - conversion template
+ * 			Size - value size in bytes, as fetched or as array element
+ * \return	number of characters or xpfUNBOUNDED
+ */
+constexpr size_t xPrintValueBound(const xpo_t & sOp, size_t Size) {
+	uint32_t	Flags = sOp.flags ;
+	size_t		MinWid = sOp.limits & xpfMINWID_MAXVAL ;
+	size_t		Precis = sOp.limits >> xpfMINWID_BITS ;
+	size_t		Len ;
+	if (sOp.cFmt == 'J') {								// width is the number of bits, at most 32/64
+		Len = (Flags & xpfFLAG_LLONG) ? 64 : 32 ;
+		if (MinWid && MinWid < Len && !(sOp.Args & xpoARG_WIDTH)) Len = MinWid ;
+		return Len + ((Flags & xpfFLAG_GROUP) ? Len - 1 : 0) ;
+	}
+	if (sOp.Args & xpoARG_WIDTH) return xpfUNBOUNDED ;
+	switch (sOp.cFmt) {
+	case 'd':
+	case 'i':
+	case 'u':
+		Len = (Size == 1) ? 3 : (Size == 2) ? 5 : (Size == 4) ? 10 : (sOp.cFmt == 'u') ? 20 : 19 ;
+		Len += xPrintGroups(Len, Flags) + ((sOp.cFmt != 'u' || (Flags & xpfFLAG_PLUS)) ? 1 : 0) ;
+		break ;
+	case 'o':
+	case 'x':
+		Len = (sOp.cFmt == 'x') ? Size * 2 : ((Size * 8) + 2) / 3 ;
+		Len += (Flags & xpfFLAG_PLUS) ? 1 : 0 ;
+		break ;
+	case 'q':
+	case 'Q':											// precision clipped to xpfMAX_FIXED_DECIMALS
+		Len = (Flags & xpfFLAG_LLONG) ? 19 : 10 ;
+		Precis = (sOp.Args & xpoARG_PRECIS) ? xpfMAX_FIXED_DECIMALS : (Flags & xpfFLAG_ARG_PREC) ? Precis : xpfDEFAULT_DECIMALS ;
+		Precis = Precis > xpfMAX_FIXED_DECIMALS ? xpfMAX_FIXED_DECIMALS : Precis ;
+		return xPrintBoundMax(MinWid, 1 + Len + xPrintGroups(Len, Flags) + 1 + Precis) ;
+	case 'e':
+	case 'f':
+	case 'g':
+	case 'a': {
+		if (sOp.Args & xpoARG_PRECIS) return xpfUNBOUNDED ;
+		// float elements widen to double, at most 39 integer digits & 44 leading fraction zeros
+		size_t	IntMax = (Size == sizeof(float)) ? 39 : 309 ;
+		size_t	Lead = (Size == sizeof(float)) ? 44 : 323 ;
+		size_t	Digits = (Flags & xpfFLAG_ARG_PREC) ? Precis : xpfDEFAULT_DECIMALS ;
+		Digits = Digits ? Digits : 1 ;
+		bool	Shortest = Flags & xpfFLAG_REL_VAL ;	// '!' at most 17 significant digits
+		size_t	ExpForm = 1 + 1 + 1 + (Shortest ? 16 : Digits) + sizeof("e+308") - 1 ;
+		if (sOp.cFmt == 'e') {
+			Len = ExpForm ;
+		} else if (sOp.cFmt == 'f') {
+			Len = 1 + IntMax + xPrintGroups(IntMax, Flags) + 1 + (Shortest ? 17 + Lead : Digits) ;
+		} else {										// 'g' fixed form while exponent < precision
+			size_t Int = Digits < IntMax ? Digits : IntMax ;
+			Len = xPrintBoundMax(ExpForm, 1 + Int + xPrintGroups(Int, Flags) + 1 + (Shortest ? 17 + 3 : Digits)) ;
+		}
+		return xPrintBoundMax(MinWid, Len) ;
+	}
+	default:
+		return sizeof("%?") - 1 ;
+	}
+	if (Precis && !(sOp.Args & xpoARG_PRECIS) && Precis < Len) Len = Precis ;	// precision truncates
+	return xPrintBoundMax(MinWid, Len) ;
+}
+
+/**
+ * xPrintOpBound()
+ * \brief	longest output of a single instruction, widths & precisions as compiled, value independent
+ * \param	sOp - instruction
+ * \return	number of characters or xpfUNBOUNDED
+ */
+constexpr size_t xPrintOpBound(const xpo_t & sOp) {
+	if (sOp.cFmt == 0) return sOp.Len ;
+	size_t	MinWid = sOp.limits & xpfMINWID_MAXVAL ;
+	size_t	Precis = sOp.limits >> xpfMINWID_BITS ;
+	if (sOp.Args & xpoARG_ARRAY) {
+		if (sOp.Args & xpoARG_COUNT) return xpfUNBOUNDED ;
+		if (sOp.Count == 0) return 0 ;
+		bool	Float = (sOp.cFmt == 'e' || sOp.cFmt == 'f' || sOp.cFmt == 'g' || sOp.cFmt == 'a') ;
+		size_t	Size = (sOp.Args & xpoARR_SIZED) ? 1 << ((sOp.Args & xpoARR_MASK) >> xpoARR_SHIFT) :
+						Float ? sizeof(double) : (sOp.flags & xpfFLAG_LLONG) ? sizeof(uint64_t) : sizeof(uint32_t) ;
+		size_t	Elem = xPrintValueBound(sOp, Size) ;
+		size_t	Sep = sOp.Sep[0] ? (sOp.Sep[1] ? 2 : 1) : 0 ;
+		return (Elem == xpfUNBOUNDED) ? xpfUNBOUNDED : (sOp.Count * Elem) + ((sOp.Count - 1) * Sep) ;
+	}
+#ifdef	configTIME_MAX_LEN_TZINFO
+	constexpr size_t Zone = configTIME_MAX_LEN_TZINFO - 1 ;
+#else
+	constexpr size_t Zone = xpfUNBOUNDED ;
+#endif
+	constexpr size_t Date = xpfMAX_LEN_DATE - 1, Time = xpfMAX_LEN_TIME - 1 ;
+	switch (sOp.cFmt) {
+	case 'c':	return 1 ;
+	case 'p':	return sizeof("0x12345678") - 1 ;
+	case 'C':	return 2 * (xpfMAX_LEN_SGR - 1) ;		// locate & attribute sequences
+	case 'I':	return xpfMAX_LEN_IP - 1 ;
+	case 'm':	return (sOp.flags & xpfFLAG_GROUP) ? xpfMAX_LEN_MAC - 1 : sizeof("0123456789ab") - 1 ;
+	case 'D':	return xPrintBoundAdd(Date, Zone) ;
+	case 'T':	return xPrintBoundAdd(Time, Zone) ;
+	case 'Z':	return xPrintBoundAdd(Date + Time, Zone) ;
+	case 'R':
+	case 'r':	return Date + Time + 1 ;				// trailing 'Z'
+	case 's':	return ((sOp.Args & (xpoARG_WIDTH | xpoARG_PRECIS)) || Precis == 0) ? xpfUNBOUNDED : xPrintBoundMax(MinWid, Precis) ;
+	case 'U':
+	case 'B':
+	case 'H':
+	case 'W':
+	case 'Y':	return xpfUNBOUNDED ;
+	case 'J':	return xPrintValueBound(sOp, (sOp.flags & xpfFLAG_LLONG) ? sizeof(uint64_t) : sizeof(uint32_t)) ;
+	default:	return xPrintValueBound(sOp, (sOp.flags & xpfFLAG_LLONG) ? sizeof(uint64_t) :
+							(sOp.cFmt == 'e' || sOp.cFmt == 'f' || sOp.cFmt == 'g' || sOp.cFmt == 'a') ? sizeof(double) : sizeof(uint32_t)) ;
+	}
+}
+
+/**
+ * xpfp_t - program & output bound of a format, static constexpr hence no run time initialisation
+ */
+template <xpfc_t F>
+struct xpfp_t {
+	static constexpr xpfl_t<sizeof(F.Str)> All = xPrintCompileFormat<sizeof(F.Str)>(F.Str) ;
+	static constexpr size_t Count = All.Count ;
+	static constexpr xpfl_t<Count> Prog = xPrintCompileTrim<Count>(All) ;
+	static constexpr size_t Bound = [] {
+		size_t Sum = 0 ;
+		for (size_t Idx = 0; Idx < Count; ++Idx) Sum = xPrintBoundAdd(Sum, xPrintOpBound(Prog.Ops[Idx])) ;
+		return Sum ;
+	}() ;
+} ;
+
+/**
+ * vPrintEmitOp()
+ * \brief	a single instruction, literal as a span, conversion with flags & limits as constants
+ * 			straight to vPrintConvert(), only '*' & array conversions go via vPrintOp()
+ */
+template <typename P, size_t I>
+inline void vPrintEmitOp(xpc_t * psXPC, xpa_t * psArgs) {
+	constexpr const xpo_t & sOp = P::Prog.Ops[I] ;
+	if constexpr (sOp.cFmt == 0) {
+		vPrintSpanRef(psXPC, sOp.pcLit, sOp.Len) ;
+	} else if constexpr (sOp.Args == 0) {
+		psXPC->f.limits	= sOp.limits ;
+		psXPC->f.flags	= sOp.flags ;
+		vPrintConvert(psXPC, sOp.cFmt, psArgs) ;
+	} else {
+		vPrintOp(psXPC, &sOp, psArgs) ;
+	}
+}
+
+template <xpfc_t F>
+inline int xPrintEmit(xpc_t * psXPC, const uint8_t * pArgs) {
+	using P = xpfp_t<F> ;
+	xpa_t	sArgs ;
+	sArgs.pArgs = pArgs ;
+	sArgs.Refs	= 1 ;
+	[&]<size_t... I>(std::index_sequence<I...>) {
+		(vPrintEmitOp<P, I>(psXPC, &sArgs), ...) ;
+	}(std::make_index_sequence<P::Count> { }) ;
+	return psXPC->f.curlen ;
+}
+
+template <xpfc_t F>
+inline int xPrintEmitString(char * pBuf, size_t szBuf, const uint8_t * pArgs) {
+	if (szBuf == 1) {									// as for snprintfx()
+		if (pBuf) *pBuf = 0 ;
+		return 0 ;
+	}
+	xpc_t	sXPC ;
+	sXPC.handler	= NULL ;
+	sXPC.writer		= xPrintToStringSpan ;
+	sXPC.pStr		= pBuf ;
+	sXPC.f.maxlen	= (szBuf > xpfMAXLEN_MAXVAL) ? xpfMAXLEN_MAXVAL : szBuf ;
+	sXPC.f.curlen	= 0 ;
+	int iRV = xPrintEmit<F>(&sXPC, pArgs) ;
+	if (pBuf) {
+		if (iRV == (int) szBuf) --iRV ;
+		pBuf[iRV] = 0 ;
+	}
+	return iRV ;
+}
+
+consteval size_t xPrintBufSize(size_t Bound) {
+	if (Bound == xpfUNBOUNDED) error_output_unbounded() ;
+	return Bound + 1 ;
+}
+
+} // namespace xpf
+
+struct printfx {
+	template <typename... Args>
+	using format = xpf::xpfs_t<std::type_identity_t<Args>...> ;
+
+	struct out_t { } ;
+	static constexpr out_t out { } ;					// sink: stdout
+
+	typedef	struct buffer {								// sink: string buffer
+		char *	pBuf ;
+		size_t	Size ;
+	} buffer ;
+
+	template <typename... Args>
+	static int print(out_t, format<Args...> fmt, Args &&... args) {
+		uint8_t	Pack[sizeof...(Args) * xpf::xpfPACK_MAX + 1] ;
+		xpf::pPrintPackArgs(Pack, fmt.Kind, args...) ;
+		return printfx_packed(fmt.pcFmt, Pack) ;
+	}
+
+	template <typename... Args>
+	static int print(buffer sBuf, format<Args...> fmt, Args &&... args) {
+		uint8_t	Pack[sizeof...(Args) * xpf::xpfPACK_MAX + 1] ;
+		xpf::pPrintPackArgs(Pack, fmt.Kind, args...) ;
+		return snprintfx_packed(sBuf.pBuf, sBuf.Size, fmt.pcFmt, Pack) ;
+	}
+
+	template <size_t N, typename... Args>
+	static int print(char (& Buf)[N], format<Args...> fmt, Args &&... args) {
+		return print(buffer { Buf, N }, fmt, static_cast<Args &&>(args)...) ;
+	}
+
+	template <typename... Args>
+	static int print(FILE * stream, format<Args...> fmt, Args &&... args) {
+		uint8_t	Pack[sizeof...(Args) * xpf::xpfPACK_MAX + 1] ;
+		xpf::pPrintPackArgs(Pack, fmt.Kind, args...) ;
+		return fprintfx_packed(stream, fmt.pcFmt, Pack) ;
+	}
+
+	template <typename... Args>
+	static int print(int fd, format<Args...> fmt, Args &&... args) {
+		uint8_t	Pack[sizeof...(Args) * xpf::xpfPACK_MAX + 1] ;
+		xpf::pPrintPackArgs(Pack, fmt.Kind, args...) ;
+		return dprintfx_packed(fd, fmt.pcFmt, Pack) ;
+	}
+
+	template <typename... Args>
+	static int print(xpc_t * psXPC, format<Args...> fmt, Args &&... args) {
+		uint8_t	Pack[sizeof...(Args) * xpf::xpfPACK_MAX + 1] ;
+		xpf::pPrintPackArgs(Pack, fmt.Kind, args...) ;
+		return xpcprintfx_packed(psXPC, fmt.pcFmt, Pack) ;
+	}
+
+	// Compile time programs: printfx::emit<"format">(sink, args...), see xpf::xpfp_t
+
+	template <xpf::xpfc_t F>
+	static constexpr size_t bound = xpf::xpfp_t<F>::Bound ;	// max chars output, xpf::xpfUNBOUNDED if value dependent
+
+	template <xpf::xpfc_t F>
+	static constexpr size_t bufsize = xpf::xPrintBufSize(bound<F>) ;	// buffer for any output, bounded formats only
+
+	template <xpf::xpfc_t F, typename... Args>
+	static int emit(xpc_t * psXPC, Args &&... args) {
+		constexpr xpf::xpfs_t<Args...> fmt { F.Str } ;
+		uint8_t	Pack[sizeof...(Args) * xpf::xpfPACK_MAX + 1] ;
+		xpf::pPrintPackArgs(Pack, fmt.Kind, args...) ;
+		return xpf::xPrintEmit<F>(psXPC, Pack) ;
+	}
+
+	template <xpf::xpfc_t F, typename... Args>
+	static int emit(buffer sBuf, Args &&... args) {
+		constexpr xpf::xpfs_t<Args...> fmt { F.Str } ;
+		uint8_t	Pack[sizeof...(Args) * xpf::xpfPACK_MAX + 1] ;
+		xpf::pPrintPackArgs(Pack, fmt.Kind, args...) ;
+		return xpf::xPrintEmitString<F>(sBuf.pBuf, sBuf.Size, Pack) ;
+	}
+
+	template <xpf::xpfc_t F, size_t N, typename... Args>
+	static int emit(char (& Buf)[N], Args &&... args) {
+		return emit<F>(buffer { Buf, N }, static_cast<Args &&>(args)...) ;
+	}
+
+	/* Stream sinks: a bounded format is rendered into a stack buffer of exactly bufsize<F> then
+	 * written as a single span by ?printfx_span(), no reparse & embedded NULs (%c) kept, else (or if
+	 * larger than xpf::xpfEMIT_STACK) as for print() */
+	template <xpf::xpfc_t F, typename... Args>
+	static int emit(out_t, Args &&... args) {
+		constexpr xpf::xpfs_t<Args...> fmt { F.Str } ;
+		uint8_t	Pack[sizeof...(Args) * xpf::xpfPACK_MAX + 1] ;
+		xpf::pPrintPackArgs(Pack, fmt.Kind, args...) ;
+		if constexpr (bound<F> < xpf::xpfEMIT_STACK) {
+			char	Buf[bound<F> + 1] ;
+			int Len = xpf::xPrintEmitString<F>(Buf, sizeof(Buf), Pack) ;
+			return printfx_span(Buf, Len) ;
+		} else {
+			return printfx_packed(F.Str, Pack) ;
+		}
+	}
+
+	template <xpf::xpfc_t F, typename... Args>
+	static int emit(FILE * stream, Args &&... args) {
+		constexpr xpf::xpfs_t<Args...> fmt { F.Str } ;
+		uint8_t	Pack[sizeof...(Args) * xpf::xpfPACK_MAX + 1] ;
+		xpf::pPrintPackArgs(Pack, fmt.Kind, args...) ;
+		if constexpr (bound<F> < xpf::xpfEMIT_STACK) {
+			char	Buf[bound<F> + 1] ;
+			int Len = xpf::xPrintEmitString<F>(Buf, sizeof(Buf), Pack) ;
+			return fprintfx_span(stream, Buf, Len) ;
+		} else {
+			return fprintfx_packed(stream, F.Str, Pack) ;
+		}
+	}
+
+	template <xpf::xpfc_t F, typename... Args>
+	static int emit(int fd, Args &&... args) {
+		constexpr xpf::xpfs_t<Args...> fmt { F.Str } ;
+		uint8_t	Pack[sizeof...(Args) * xpf::xpfPACK_MAX + 1] ;
+		xpf::pPrintPackArgs(Pack, fmt.Kind, args...) ;
+		if constexpr (bound<F> < xpf::xpfEMIT_STACK) {
+			char	Buf[bound<F> + 1] ;
+			int Len = xpf::xPrintEmitString<F>(Buf, sizeof(Buf), Pack) ;
+			return dprintfx_span(fd, Buf, Len) ;
+		} else {
+			return dprintfx_packed(fd, F.Str, Pack) ;
+		}
+	}
+} ;
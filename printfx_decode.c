@@ -0,0 +1,523 @@
+/*
+ * Copyright 2021 Andre M. Maree / KSS Technologies (Pty) Ltd.
+ *
+ * printfx_decode.c - Linux host decoder for deferred (binary) printfx records
+ *
+ * Records captured on the device by DPRINT()/DTRACK() and exported with xPrintDeferredRead() are
+ * rendered using the same xpcprintfx() engine. Format addresses are resolved directly against the
+ * allocated sections (string table) of the firmware ELF file.
+ *
+ * Usage:	printfx_decode [-j threads] firmware.elf [capture.bin]	(stdin if no capture file)
+ * Build:	cc -O2 printfx_decode.c printfx.c <support libraries> -lpthread -o printfx_decode
+ *
+ * MUST be built with the same xpfSUPPORT_??? selection as the firmware, that determines which
+ * conversions have arguments captured. Input is read in large blocks, each split at record
+ * boundaries into parts decoded in parallel, output is written in the original order.
+ * Records are independent EXCEPT for %Y where the context carries an incomplete row from one
+ * record to the next, use "-j 1" if streamed hexdumps must be exact.
+ * Time zone info referenced from a TSZ_t is not available on the host, shown as 'Z' (UTC)
+ */
+
+#include	"printfx.h"
+
+#include	<elf.h>
+#include	<fcntl.h>
+#include	<pthread.h>
+#include	<stdlib.h>
+#include	<string.h>
+#include	<sys/mman.h>
+#include	<sys/stat.h>
+#include	<unistd.h>
+
+// ########################################### Macros ##############################################
+
+#define	decBLOCK_SIZE					(16 << 20)	// input bytes per worker per round
+#define	decMAX_THREADS					64
+#define	decMAX_SECTIONS					64
+#define	decFMT_CACHE					1024		// formats per worker, MUST be a power of 2
+#define	decMAX_CONTEXTS					16			// %Y contexts per worker
+#define	decARGS_MAX						(xpfDEFER_REC_MAX * 2)	// host layout, pointers widened
+
+// ######################################## Local structures #######################################
+
+typedef	struct dsec_t {									// allocated ELF section
+	uint64_t		Addr ;
+	uint64_t		Size ;
+	const char *	pcData ;
+} dsec_t ;
+
+typedef	struct dfmt_t {									// format cache entry
+	uint64_t		Addr ;								// target address
+	const char *	pcFmt ;								// in the mapped ELF, NULL if not found
+	xpp_t *			psProg ;							// compiled, NULL if not (yet) compiled
+	uint8_t			Tried ;
+} dfmt_t ;
+
+typedef	struct dctx_t {									// %Y context, host copy
+	uint64_t		Addr ;								// target address
+	xpd_t			sXPD ;
+} dctx_t ;
+
+typedef	struct dout_t {									// growing output buffer
+	char *			pBuf ;
+	size_t			Used ;
+	size_t			Size ;
+} dout_t ;
+
+typedef	struct dcur_t {									// record translation cursor
+	const uint8_t *	pSrc ;
+	const uint8_t *	pEnd ;
+	uint8_t *		pDst ;
+	uint8_t *		pLim ;
+} dcur_t ;
+
+typedef	struct dwrk_t {									// worker, state persists across rounds
+	pthread_t		Thread ;
+	const uint8_t *	pIn ;
+	size_t			Len ;
+	dout_t			sOut ;
+	uint64_t		Records ;
+	uint64_t		Unknown ;
+	int				NextCtx ;
+	dfmt_t			Fmt[decFMT_CACHE] ;
+	dctx_t			Ctx[decMAX_CONTEXTS] ;
+} dwrk_t ;
+
+// ######################################## Local variables ########################################
+
+static	struct {
+	const uint8_t *	pMap ;
+	size_t			Size ;
+	int				PtrSize ;							// target pointer size, 4 or 8
+	int				HdrSize ;							// target sizeof(xpdh_t)
+	int				Count ;
+	dsec_t			Sec[decMAX_SECTIONS] ;
+} sElf ;
+
+// ######################################### ELF string table ######################################
+
+static	void vDecodeElfSection(uint32_t Type, uint64_t Flags, uint64_t Addr, uint64_t Size, uint64_t Offset) {
+	if (Type != SHT_PROGBITS || (Flags & SHF_ALLOC) == 0 || Size == 0) return ;
+	if (Offset > sElf.Size || Size > sElf.Size - Offset || sElf.Count == decMAX_SECTIONS) return ;
+	dsec_t * psS = &sElf.Sec[sElf.Count++] ;
+	psS->Addr	= Addr ;
+	psS->Size	= Size ;
+	psS->pcData	= (const char *) sElf.pMap + Offset ;
+}
+
+/**
+ * xDecodeElfOpen() - map the firmware ELF file & build the list of allocated sections
+ * \param	pcName - ELF file name
+ * \return	erSUCCESS or erFAILURE if not a little endian ELF file with allocated sections
+ */
+static	int	xDecodeElfOpen(const char * pcName) {
+	struct stat	sStat ;
+	int fd = open(pcName, O_RDONLY) ;
+	if (fd < 0) return erFAILURE ;
+	if (fstat(fd, &sStat) < 0 || sStat.st_size < (off_t) sizeof(Elf64_Ehdr)) {
+		close(fd) ;
+		return erFAILURE ;
+	}
+	void * pMap = mmap(NULL, sStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0) ;
+	close(fd) ;
+	if (pMap == MAP_FAILED) return erFAILURE ;
+	sElf.pMap	= pMap ;
+	sElf.Size	= sStat.st_size ;
+	const unsigned char * pID = sElf.pMap ;
+	if (memcmp(pID, ELFMAG, SELFMAG) || pID[EI_DATA] != ELFDATA2LSB) return erFAILURE ;
+	if (pID[EI_CLASS] == ELFCLASS32) {
+		const Elf32_Ehdr * psE = pMap ;
+		if (psE->e_shoff + (uint64_t) psE->e_shnum * psE->e_shentsize > sElf.Size) return erFAILURE ;
+		for (int Idx = 0; Idx < psE->e_shnum; ++Idx) {
+			const Elf32_Shdr * psS = (const Elf32_Shdr *) (sElf.pMap + psE->e_shoff + Idx * psE->e_shentsize) ;
+			vDecodeElfSection(psS->sh_type, psS->sh_flags, psS->sh_addr, psS->sh_size, psS->sh_offset) ;
+		}
+		sElf.PtrSize = sizeof(uint32_t) ;
+	} else if (pID[EI_CLASS] == ELFCLASS64) {
+		const Elf64_Ehdr * psE = pMap ;
+		if (psE->e_shoff + (uint64_t) psE->e_shnum * psE->e_shentsize > sElf.Size) return erFAILURE ;
+		for (int Idx = 0; Idx < psE->e_shnum; ++Idx) {
+			const Elf64_Shdr * psS = (const Elf64_Shdr *) (sElf.pMap + psE->e_shoff + Idx * psE->e_shentsize) ;
+			vDecodeElfSection(psS->sh_type, psS->sh_flags, psS->sh_addr, psS->sh_size, psS->sh_offset) ;
+		}
+		sElf.PtrSize = sizeof(uint64_t) ;
+	} else {
+		return erFAILURE ;
+	}
+	sElf.HdrSize = 2 * sElf.PtrSize ;					// U32 Hdr padded to pointer alignment + pcFmt
+	return sElf.Count ? erSUCCESS : erFAILURE ;
+}
+
+/**
+ * psDecodeFormat() - locate the format string for a target address, cached per worker
+ */
+static	dfmt_t * psDecodeFormat(dwrk_t * psW, uint64_t Addr) {
+	dfmt_t * psF = &psW->Fmt[((Addr >> 2) ^ (Addr >> 13)) & (decFMT_CACHE - 1)] ;
+	if (psF->Addr == Addr && psF->Tried) return psF ;
+	free(psF->psProg) ;
+	psF->Addr	= Addr ;
+	psF->pcFmt	= NULL ;
+	psF->psProg	= NULL ;
+	psF->Tried	= 1 ;
+	for (int Idx = 0; Idx < sElf.Count; ++Idx) {
+		dsec_t * psS = &sElf.Sec[Idx] ;
+		if (Addr < psS->Addr || Addr - psS->Addr >= psS->Size) continue ;
+		const char * pcFmt = psS->pcData + (Addr - psS->Addr) ;
+		if (memchr(pcFmt, 0, psS->Size - (Addr - psS->Addr)) == NULL) break ;	// not terminated
+		psF->pcFmt = pcFmt ;
+		psF->psProg = malloc(sizeof(xpp_t)) ;
+		if (psF->psProg && xPrintCompile(psF->psProg, pcFmt) == erFAILURE) {
+			free(psF->psProg) ;							// too many ops, parsed per record
+			psF->psProg = NULL ;
+		}
+		break ;
+	}
+	return psF ;
+}
+
+// ###################################### Record translation #######################################
+
+/* Target records have values in the target layout, only pointers differ in size on the host.
+ * Each record is translated into the host (native) layout & then formatted by xpcprintfx_record_prog()
+ * with the program compiled per format here, workers never touch the shared program cache */
+
+static	int	xDecodeCopy(dcur_t * psC, size_t Len) {
+	if (Len > (size_t) (psC->pEnd - psC->pSrc) || Len > (size_t) (psC->pLim - psC->pDst)) return 0 ;
+	memcpy(psC->pDst, psC->pSrc, Len) ;
+	psC->pSrc += Len ;
+	psC->pDst += Len ;
+	return 1 ;
+}
+
+static	int	xDecodePut(dcur_t * psC, const void * pVal, size_t Len) {
+	if (Len > (size_t) (psC->pLim - psC->pDst)) return 0 ;
+	memcpy(psC->pDst, pVal, Len) ;
+	psC->pDst += Len ;
+	return 1 ;
+}
+
+static	int	xDecodeGet(dcur_t * psC, void * pVal, size_t Len) {
+	if (Len > (size_t) (psC->pEnd - psC->pSrc)) return 0 ;
+	memcpy(pVal, psC->pSrc, Len) ;
+	psC->pSrc += Len ;
+	return 1 ;
+}
+
+static	int	xDecodePtr(dcur_t * psC, uint64_t * pAddr) {
+	uint64_t	Addr = 0 ;
+	if (xDecodeGet(psC, &Addr, sElf.PtrSize) == 0) return 0 ;
+	if (pAddr) *pAddr = Addr ;
+	uintptr_t	Host = (uintptr_t) Addr ;
+	return xDecodePut(psC, &Host, sizeof(Host)) ;
+}
+
+static	int	xDecodeData(dcur_t * psC) {						// pointer, U16 length & data
+	uint16_t	Len ;
+	if (xDecodePtr(psC, NULL) == 0 || xDecodeGet(psC, &Len, sizeof(Len)) == 0) return 0 ;
+	psC->pSrc -= sizeof(Len) ;
+	return xDecodeCopy(psC, sizeof(Len) + Len) ;
+}
+
+static	xpd_t * psDecodeContext(dwrk_t * psW, uint64_t Addr, int Size) {
+	for (int Idx = 0; Idx < decMAX_CONTEXTS; ++Idx) {
+		if (psW->Ctx[Idx].Addr == Addr) return &psW->Ctx[Idx].sXPD ;
+	}
+	dctx_t * psX = &psW->Ctx[psW->NextCtx] ;			// new context, oldest replaced
+	psW->NextCtx = (psW->NextCtx + 1) % decMAX_CONTEXTS ;
+	psX->Addr = Addr ;
+	vPrintDumpInit(&psX->sXPD, Size) ;
+	return &psX->sXPD ;
+}
+
+/**
+ * xDecodeOp() - translate the argument(s) of a single instruction, mirrors xPrintDeferOp()
+ * \return	1 if translated, 0 if the record does not match the format
+ */
+static	int	xDecodeOp(dwrk_t * psW, dcur_t * psC, const xpo_t * psOp) {
+	xpf_t	f ;
+	if (psOp->cFmt == 0) return 1 ;
+	f.flags = psOp->flags ;
+#if		(xpfSUPPORT_ARRAYS == 1)
+	if ((psOp->Args & xpoARG_COUNT) && xDecodeCopy(psC, sizeof(int)) == 0) return 0 ;
+#endif
+	if ((psOp->Args & xpoARG_WIDTH) && xDecodeCopy(psC, sizeof(int)) == 0) return 0 ;
+	if ((psOp->Args & xpoARG_PRECIS) && xDecodeCopy(psC, sizeof(int)) == 0) return 0 ;
+#if		(xpfSUPPORT_ARRAYS == 1)
+	if (psOp->Args & xpoARG_ARRAY) return xDecodeData(psC) ;	// elements, same layout on host
+#endif
+	switch (psOp->cFmt) {
+#if		(xpfSUPPORT_SGR == 1)
+	case CHR_C:
+#endif
+#if		(xpfSUPPORT_IP_ADDR == 1)
+	case CHR_I:
+#endif
+#if		(xpfSUPPORT_DATETIME == 1)
+	case CHR_r:
+#endif
+	case CHR_c:
+		return xDecodeCopy(psC, sizeof(uint32_t)) ;
+
+#if		(xpfSUPPORT_BINARY == 1)
+	case CHR_J:
+#endif
+	case CHR_d:
+	case CHR_i:
+	case CHR_o:
+	case CHR_x:
+	case CHR_u:
+		return xDecodeCopy(psC, f.llong ? sizeof(uint64_t) : sizeof(uint32_t)) ;
+
+#if		(xpfSUPPORT_DATETIME == 1)
+	case CHR_R:
+		return xDecodeCopy(psC, sizeof(uint64_t)) ;
+
+	case CHR_D:
+	case CHR_T:
+	case CHR_Z: {										// only usecs, zone info is target memory
+		TSZ_t		sTSZ = { 0 } ;
+		uint16_t	Len ;
+		if (xDecodePtr(psC, NULL) == 0 || xDecodeGet(psC, &Len, sizeof(Len)) == 0) return 0 ;
+		if (Len < sizeof(sTSZ.usecs) || Len > (size_t) (psC->pEnd - psC->pSrc)) return 0 ;
+		memcpy(&sTSZ.usecs, psC->pSrc, sizeof(sTSZ.usecs)) ;
+		psC->pSrc += Len ;
+		Len = sizeof(TSZ_t) ;
+		return xDecodePut(psC, &Len, sizeof(Len)) && xDecodePut(psC, &sTSZ, sizeof(TSZ_t)) ;
+	}
+#endif
+
+#if		(xpfSUPPORT_URL == 1)
+	case CHR_U:
+		return xDecodeData(psC) ;
+#endif
+
+#if		(xpfSUPPORT_HEXDUMP == 1)
+	case CHR_Y: {										// context replaced by a host copy
+		uint64_t	Addr ;
+		uint8_t		Size ;
+		if (xDecodeGet(psC, &Addr, sElf.PtrSize) == 0 || xDecodeGet(psC, &Size, sizeof(Size)) == 0) return 0 ;
+		if (Size > xpfSIZING_DWORD) return 0 ;
+		xpd_t * psXPD = psDecodeContext(psW, Addr & (sElf.PtrSize == 4 ? 0xFFFFFFFFULL : ~0ULL), Size) ;
+		if (xDecodePut(psC, &psXPD, sizeof(psXPD)) == 0 || xDecodePut(psC, &Size, sizeof(Size)) == 0) return 0 ;
+	}
+		/* FALLTHRU */ /* no break */
+	case CHR_B:
+	case CHR_H:
+	case CHR_W:
+		return xDecodeCopy(psC, sizeof(int)) && xDecodeData(psC) ;
+#endif
+
+#if		(xpfSUPPORT_MAC_ADDR == 1)
+	case CHR_m:
+		return xDecodeData(psC) ;
+#endif
+
+#if		(xpfSUPPORT_FIXEDPOINT == 1)
+	case CHR_Q:
+	case CHR_q:
+		return xDecodeCopy(psC, sizeof(int)) && xDecodeCopy(psC, f.llong ? sizeof(uint64_t) : sizeof(uint32_t)) ;
+#endif
+
+#if		(xpfSUPPORT_IEEE754 == 1)
+	case CHR_e:
+	case CHR_f:
+	case CHR_a:
+	case CHR_g:
+		return xDecodeCopy(psC, sizeof(double)) ;
+#endif
+
+#if		(xpfSUPPORT_POINTER == 1)
+	case CHR_p:
+		return xDecodePtr(psC, NULL) ;
+#endif
+
+	case CHR_s:
+		return xDecodeData(psC) ;
+
+	default:											// no argument
+		return 1 ;
+	}
+}
+
+// ############################################ Output #############################################
+
+static	int	xDecodeToOut(xpc_t * psXPC, const char * pStr, size_t szLen) {
+	dout_t * psO = psXPC->pVoid ;
+	if (psO->Used + szLen > psO->Size) {
+		size_t Size = psO->Size ? psO->Size : (1 << 20) ;
+		while (Size < psO->Used + szLen) Size *= 2 ;
+		char * pBuf = realloc(psO->pBuf, Size) ;
+		if (pBuf == NULL) return 0 ;
+		psO->pBuf = pBuf ;
+		psO->Size = Size ;
+	}
+	memcpy(psO->pBuf + psO->Used, pStr, szLen) ;
+	psO->Used += szLen ;
+	return szLen ;
+}
+
+static	void vDecodeOut(dwrk_t * psW, const char * format, ...) {
+	va_list vArgs ;
+	va_start(vArgs, format) ;
+	xprintfx_span(xDecodeToOut, &psW->sOut, xpfMAXLEN_MAXVAL, format, vArgs) ;
+	va_end(vArgs) ;
+}
+
+/**
+ * vDecodeRecord() - translate a single target record to host layout & format it
+ * \param	pRec - record, starting with the U32 header
+ * 			Len - record length from the header
+ */
+static	void vDecodeRecord(dwrk_t * psW, const uint8_t * pRec, uint32_t Len) {
+	uint8_t		Args[decARGS_MAX] __attribute__((aligned(sizeof(uintptr_t)))) ;
+	uint64_t	Addr = 0 ;
+	memcpy(&Addr, pRec + sElf.PtrSize, sElf.PtrSize) ;
+	dfmt_t * psF = psDecodeFormat(psW, Addr) ;
+	if (psF->pcFmt == NULL) {
+		vDecodeOut(psW, "<format 0x%llx not in ELF, %u bytes>\n", (unsigned long long) Addr, Len) ;
+		++psW->Unknown ;
+		return ;
+	}
+	dcur_t	sC = { .pSrc = pRec + sElf.HdrSize, .pEnd = pRec + Len, .pDst = Args, .pLim = Args + sizeof(Args) } ;
+	int		iRV = 1 ;
+	if (psF->psProg) {
+		for (int Idx = 0; iRV && Idx < psF->psProg->Count; ++Idx) iRV = xDecodeOp(psW, &sC, &psF->psProg->Ops[Idx]) ;
+	} else {
+		xpo_t	sOp ;
+		for (const char * fmt = pcPrintNextSpec(psF->pcFmt); iRV && *fmt; fmt = pcPrintNextSpec(fmt)) {
+			fmt = pcPrintParseSpec(&sOp, fmt + 1) ;
+			if (*fmt == 0) break ;						// '%' ending the format
+			iRV = xDecodeOp(psW, &sC, &sOp) ;
+			++fmt ;
+		}
+	}
+	if (iRV == 0) {
+		vDecodeOut(psW, "<record does not match format \"%s\">\n", psF->pcFmt) ;
+		++psW->Unknown ;
+		return ;
+	}
+	xpc_t	sXPC ;
+	sXPC.handler	= NULL ;
+	sXPC.writer		= xDecodeToOut ;
+	sXPC.pVoid		= &psW->sOut ;
+	sXPC.f.maxlen	= xpfMAXLEN_MAXVAL ;
+	sXPC.f.curlen	= 0 ;
+	xpcprintfx_record_prog(&sXPC, psF->psProg, psF->pcFmt, Args) ;	// own program, no shared cache
+	++psW->Records ;
+}
+
+static	void * pvDecodeWorker(void * pvPara) {
+	dwrk_t * psW = pvPara ;
+	psW->sOut.Used = 0 ;
+	for (size_t Pos = 0; Pos < psW->Len; ) {				// boundaries validated by xDecodeSplit()
+		uint32_t Hdr ;
+		memcpy(&Hdr, psW->pIn + Pos, sizeof(Hdr)) ;
+		if ((Hdr >> 16) == xpfDEFER_REC) vDecodeRecord(psW, psW->pIn + Pos, Hdr & 0xFFFF) ;
+		Pos += Hdr & 0xFFFF ;
+	}
+	return NULL ;
+}
+
+/**
+ * xDecodeSplit() - validate record headers & split complete records into similar sized parts
+ * \param	pIn - block of input
+ * 			Fill - bytes in block
+ * 			psW - workers, pIn & Len set for each part
+ * 			Threads - number of parts
+ * 			pBad - set if an invalid header found
+ * \return	length of complete records, remainder to be carried to the next block
+ */
+static	size_t	xDecodeSplit(const uint8_t * pIn, size_t Fill, dwrk_t * psW, int Threads, int * pBad) {
+	size_t	Pos = 0, Start = 0, Part = (Fill / Threads) + 1 ;
+	int		Idx = 0 ;
+	while (Fill - Pos >= sizeof(uint32_t)) {
+		uint32_t Hdr ;
+		memcpy(&Hdr, pIn + Pos, sizeof(Hdr)) ;
+		uint32_t Len = Hdr & 0xFFFF ;
+		if (Len < (uint32_t) sElf.HdrSize || (Len % sElf.PtrSize) || ((Hdr >> 16) != xpfDEFER_REC && (Hdr >> 16) != xpfDEFER_PAD)) {
+			*pBad = 1 ;
+			break ;
+		}
+		if (Len > Fill - Pos) break ;					// incomplete
+		Pos += Len ;
+		if (Pos - Start >= Part && Idx < Threads - 1) {
+			psW[Idx].pIn = pIn + Start ;
+			psW[Idx++].Len = Pos - Start ;
+			Start = Pos ;
+		}
+	}
+	for (; Idx < Threads; ++Idx) {
+		psW[Idx].pIn = pIn + Start ;
+		psW[Idx].Len = Pos - Start ;
+		Start = Pos ;
+	}
+	return Pos ;
+}
+
+// ############################################# Main ##############################################
+
+int	main(int argc, char * argv[]) {
+	int		Threads = sysconf(_SC_NPROCESSORS_ONLN), Opt ;
+	while ((Opt = getopt(argc, argv, "j:")) != -1) {
+		if (Opt == 'j') Threads = atoi(optarg) ;
+		else optind = argc + 1 ;
+	}
+	if (optind >= argc || optind + 2 < argc) {
+		fprintf(stderr, "usage: %s [-j threads] firmware.elf [capture.bin]\n", argv[0]) ;
+		return 2 ;
+	}
+	Threads = Threads < 1 ? 1 : Threads > decMAX_THREADS ? decMAX_THREADS : Threads ;
+	if (xDecodeElfOpen(argv[optind]) == erFAILURE) {
+		fprintf(stderr, "%s: not a usable ELF file\n", argv[optind]) ;
+		return 1 ;
+	}
+	int fd = (optind + 1 < argc) ? open(argv[optind + 1], O_RDONLY) : STDIN_FILENO ;
+	if (fd < 0) {
+		perror(argv[optind + 1]) ;
+		return 1 ;
+	}
+	#ifdef POSIX_FADV_SEQUENTIAL
+	posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL) ;
+	#endif
+	dwrk_t *	psW = calloc(Threads, sizeof(dwrk_t)) ;
+	size_t		Size = (size_t) decBLOCK_SIZE * Threads, Fill = 0 ;
+	uint8_t *	pIn = malloc(Size) ;
+	uint64_t	Offset = 0 ;
+	int			Bad = 0, Eof = 0 ;
+	if (psW == NULL || pIn == NULL) {
+		fprintf(stderr, "out of memory\n") ;
+		return 1 ;
+	}
+	while (Eof == 0 && Bad == 0) {
+		while (Fill < Size) {							// fill the block
+			ssize_t Now = read(fd, pIn + Fill, Size - Fill) ;
+			if (Now <= 0) {
+				Eof = 1 ;
+				break ;
+			}
+			Fill += Now ;
+		}
+		size_t Used = xDecodeSplit(pIn, Fill, psW, Threads, &Bad) ;
+		if (Threads == 1) {
+			pvDecodeWorker(psW) ;
+		} else {
+			for (int Idx = 0; Idx < Threads; ++Idx) pthread_create(&psW[Idx].Thread, NULL, pvDecodeWorker, &psW[Idx]) ;
+			for (int Idx = 0; Idx < Threads; ++Idx) pthread_join(psW[Idx].Thread, NULL) ;
+		}
+		for (int Idx = 0; Idx < Threads; ++Idx) fwrite(psW[Idx].sOut.pBuf, 1, psW[Idx].sOut.Used, stdout) ;
+		if (Bad) fprintf(stderr, "invalid record header at offset %llu\n", (unsigned long long) (Offset + Used)) ;
+		memmove(pIn, pIn + Used, Fill - Used) ;
+		Offset += Used ;
+		Fill -= Used ;
+	}
+	fflush(stdout) ;
+	if (Fill && Bad == 0) fprintf(stderr, "incomplete record at offset %llu\n", (unsigned long long) Offset) ;
+	uint64_t Records = 0, Unknown = 0 ;
+	for (int Idx = 0; Idx < Threads; ++Idx) {
+		Records += psW[Idx].Records ;
+		Unknown += psW[Idx].Unknown ;
+	}
+	fprintf(stderr, "%llu records decoded, %llu not decoded, %llu bytes\n", (unsigned long long) Records,
+		(unsigned long long) Unknown, (unsigned long long) Offset) ;
+	return (Bad || Unknown) ? 1 : 0 ;
+}
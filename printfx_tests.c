@@ -7,10 +7,28 @@
 
 #include	"hal_variables.h"
 #include	"printfx.h"
+#include	"formprint.h"
 
 #include	<string.h>
 #include	<float.h>									// DBL_MIN/MAX
 
+#ifdef	ESP_PLATFORM
+	#include	<xtensa/hal.h>							// xthal_get_ccount()
+	#include	"esp_timer.h"							// esp_timer_get_time()
+	#include	"lwip/sockets.h"						// loopback socket benchmark
+	#include	"socketsX.h"
+	#include	"x_ubuf.h"								// uprintfx() wrap & truncation test
+#elif	defined(__x86_64__) || defined(__i386__)
+	#include	<x86intrin.h>							// __rdtsc()
+#else
+	#include	<time.h>
+#endif
+
+#ifndef	ESP_PLATFORM
+	#include	<fcntl.h>								// open() for handle benchmark
+	#include	<unistd.h>								// pread() for threaded hexdump file
+#endif
+
 #define	debugFLAG					0xE001
 
 #define	debugTIMING					(debugFLAG_GLOBAL & debugFLAG & 0x1000)
@@ -28,6 +46,42 @@
 #define		TEST_DATETIME	1
 #define		TEST_HEXDUMP	1
 #define		TEST_WIDTH_PREC	1
+#define		TEST_FORMAT_END	1
+#define		TEST_DEFERRED	1
+#define		TEST_LOGLEVEL	1
+#define		TEST_RATELIMIT	1
+#define		TEST_ARRAY		1
+#define		TEST_BATCH		1
+#define		TEST_PACKED		1
+#define		TEST_UBUF		1
+#define		TEST_ASYNC		1						// LAST, leaves stdout asynchronous
+
+#if		(xpfSUPPORT_BATCH == 1)
+typedef	struct __attribute__((packed)) sensor_t {		// packed, fields unaligned
+	uint8_t		Id ;
+	int16_t		Temp ;									// 0.01 degC
+	float		Humid ;
+	uint32_t	Count ;
+	const char *	pcName ;
+	char		Unit[4] ;
+	uint16_t	Hist[3] ;
+} sensor_t ;
+
+static	const sensor_t sSensors[] = {
+	{ 1, -1250,  45.5f, 12, "outside", "C", { 1, 2, 3 } },
+	{ 2,  2150,  60.25f, 0, "lounge", "C", { 10, 20, 30 } },
+	{ 3,  7300, 100.0f, 4000000000U, NULL, "F", { 65535, 0, 7 } },
+	{ 4,     0,   0.0f, 1, "garage", "C", { 4, 5, 6 } },
+} ;
+
+static	const xpbf_t sSensorFields[] = {
+	xpfFIELD(sensor_t, Id, U8), xpfFIELD(sensor_t, pcName, PTR), xpfFIELD(sensor_t, Temp, I16),
+	xpfFIELD(sensor_t, Temp, I16), xpfFIELD(sensor_t, Humid, F32), xpfFIELD(sensor_t, Count, U32),
+	xpfFIELD(sensor_t, Unit, REF), xpfFIELD(sensor_t, Hist, REF),
+} ;
+
+#define	TEST_BATCH_FMT	"%u,%s,%d,%04x,%.2f,%'u,%s,%[3h;]u\n"
+#endif
 
 void	vPrintfUnitTest(void) {
 #if		(TEST_INTEGER == 1)
@@ -116,6 +170,13 @@ uint64_t	my_llong = 0x98765432 ;
 	printfx("%'.12G = double(G)\n", my_double*10000.0) ;
 
 	printfx("%.20f is a double\n", 22.0/7.0) ;
+	printfx("%.60f exact, %.1f %.2f %.3f half even\n", 0.1, 0.25, 0.125, 0.0625) ;
+	printfx("%!g %!e %!f %!g shortest round trip\n", 0.1, 1e22, 1.0/3.0, 5e-324) ;
+	#if (xpfSUPPORT_FIXEDPOINT == 1)
+	printfx("%q %.1q %q %.2Q %Q fixed point\n", 3, 12345, 3, -12345, 0, 7, 16, 0x00018000, 8, -0x80) ;
+	printfx("[%'+015.2llq] [%-10.3Q] grouped/justified fixed point\n", 4, 123456789012345LL, 16, 0x0003243F) ;
+	printfx("[%#'llq] [%.19llQ] [%.25q] '#' ignored, precision limit\n", 0, 123456789012LL, 60, 0x0123456789ABCDEFLL, 2, 314) ;
+	#endif
 	printfx("+ format: int: %+d, %+d, double: %+.1f, %+.1f, reset: %d, %.1f\n", 3, -3, 3.0, -3.0, 3, 3.0) ;
 
 	printfx("multiple doubles: %f %.1f %2.0f %.2f %.3f %.2f [%-8.3f]\n", 3.45, 3.93, 2.45, -1.1, 3.093, 13.72, -4.382) ;
@@ -181,6 +242,7 @@ uint64_t	my_llong = 0x98765432 ;
 	printfx("Elapsed S2      : %!`R\n", RunTime) ;
 	printfx("Elapsed S1 x3uS : %!.R\n", RunTime) ;
 	printfx("Elapsed S2 x6uS : %!`.6R\n", RunTime) ;
+	printfx("Elapsed days    : %!'.6R %!.3R\n", 1000 * 86401001000ULL, 100 * 86400000000ULL) ;
 
 	seconds_t	Seconds ;
 	uint64_t uSecs ;
@@ -222,6 +284,38 @@ uint64_t	my_llong = 0x98765432 ;
 	for (int32_t idx = 0; idx < 16; idx++) {
 		printfx("\nDUMP relative lc BYTE %!'+B", idx, DumpData) ;
 	}
+	xpd_t	sXPD ;
+	vPrintDumpInit(&sXPD, xpfSIZING_SHORT) ;
+	printfx("\nDUMP streamed relative UC half\n") ;
+	for (int32_t idx = 0, len = 1; idx < (int32_t) DUMPSIZE; idx += len, len += 7) {
+		printfx("%!'+Y", &sXPD, ((int32_t) DUMPSIZE - idx) < len ? (int32_t) DUMPSIZE - idx : len, DumpData + idx) ;
+	}
+	printfx("%!'+Y", &sXPD, 0, NULL) ;					// flush incomplete row
+	uint8_t	SqzData[200] = { [0] = 0x55, [150] = 0xAA } ;
+	printfx("DUMP relative squeezed byte\n%!=+B", sizeof(SqzData), SqzData) ;
+	#if		(xpfSUPPORT_HEXDUMP == 1) && (xpfSUPPORT_HEXDUMP_MT == 1) && defined(__linux__)
+	static	char	DumpST[65536], DumpMT[65536] ;
+	static	uint8_t	DumpSrc[16005] ;						// 500 complete rows + partial row
+	for (int32_t idx = 0; idx < (int32_t) sizeof(DumpSrc); ++idx) DumpSrc[idx] = idx * 131 ;
+	const char * pcSpec[] = { "%+B", "%!'+H", "%-llW" } ;
+	for (int32_t idx = 0; idx < 3; ++idx) {
+		int		LenST = snprintfx(DumpST, sizeof(DumpST), pcSpec[idx], sizeof(DumpSrc), DumpSrc) ;
+		int64_t	LenMT = xPrintHexDumpMT(DumpMT, sizeof(DumpMT), pcSpec[idx], DumpSrc, sizeof(DumpSrc), 4) ;
+		printfx("DUMP threaded %-6s %lld chars %s single\n", pcSpec[idx], LenMT,
+			(LenMT == LenST && memcmp(DumpST, DumpMT, LenST) == 0) ? "==" : "!=") ;
+	}
+	FILE *	fpDump = tmpfile() ;
+	if (fpDump) {										// appended at the file offset
+		int fd = fileno(fpDump) ;
+		write(fd, "DUMP\n", 5) ;
+		int64_t	LenMT = xPrintHexDumpFile(fd, "%!'+H", DumpSrc, sizeof(DumpSrc), 4) ;
+		int		LenST = snprintfx(DumpST, sizeof(DumpST), "DUMP\n%!'+H", sizeof(DumpSrc), DumpSrc) ;
+		int		Same = (lseek(fd, 0, SEEK_CUR) == LenST) && (pread(fd, DumpMT, LenST, 0) == LenST) && memcmp(DumpST, DumpMT, LenST) == 0 ;
+		printfx("DUMP threaded to file %lld chars %s single\n", LenMT, Same ? "==" : "!=") ;
+		fclose(fpDump) ;
+	}
+	printfx("DUMP threaded squeezed %lld\n", xPrintHexDumpMT(NULL, 0, "%=B", DumpSrc, sizeof(DumpSrc), 4)) ;
+	#endif
 #endif
 
 #if		(TEST_WIDTH_PREC == 1)
@@ -234,4 +328,445 @@ uint64_t	my_llong = 0x98765432 ;
 	printfx("Float  : Variables 30.14 : %*.*f\n",  30,  14, F64) ;
 	printfx("Float  : Specified 30.14 : %30.14f\n", F64) ;
 #endif
+
+#if		(TEST_FORMAT_END == 1)
+	{	// a '%' ending the format converts nothing, on every path (parsed, cached, packed, batch, deferred)
+		static const char * const pcEnd[] = { "%%x%", "abc%" } ;
+		for (int Idx = 0; Idx < 2; ++Idx) {
+			char	Parsed[16], Cached[16], Packed[16] ;
+			int		L0 = snprintfx(Parsed, sizeof(Parsed), pcEnd[Idx]) ;
+		#if		(xpfSUPPORT_PROGRAMS == 1)
+			int		L1 = snprintfx_cached(Cached, sizeof(Cached), pcEnd[Idx]) ;
+		#else
+			int		L1 = snprintfx(Cached, sizeof(Cached), pcEnd[Idx]) ;
+		#endif
+		#if		(xpfSUPPORT_PACKED == 1)
+			int		L2 = snprintfx_packed(Packed, sizeof(Packed), pcEnd[Idx], &Idx) ;
+		#else
+			int		L2 = snprintfx(Packed, sizeof(Packed), pcEnd[Idx]) ;
+		#endif
+			printfx("End %%  : [%s] %d [%s] %d [%s] %d\n", Parsed, L0, Cached, L1, Packed, L2) ;
+		}
+	#if		(xpfSUPPORT_BATCH == 1)
+		char	Batch[16] ;
+		xpb_t	sOne = { .pvBase = sSensors, .psField = sSensorFields, .Stride = sizeof(sensor_t),
+						.Next = 0, .Count = 2, .Fields = 1 } ;
+		int		LB = snprintfx_batch(Batch, sizeof(Batch), "%u,%", &sOne) ;
+		printfx("End %%  : batch [%s] %d\n", Batch, LB) ;
+	#endif
+	#if		(xpfSUPPORT_DEFERRED == 1)
+		DPRINT("End %%  : deferred %d\n%", 7) ;
+		xPrintDeferredDrain(stdout, 0) ;
+	#endif
+	}
+#endif
+
+#if		(TEST_DEFERRED == 1) && (xpfSUPPORT_DEFERRED == 1)
+	char	Name[] = "sensor" ;
+	uint8_t	Mac[lenMAC_ADDRESS] = { 0x00, 0x1A, 0x2B, 0x3C, 0x4D, 0x5E } ;
+	DPRINT("Deferred : %d %'llu %.3f %*s %'M\n", -1, 1234567890123ULL, 3.14159, 8, Name, Mac) ;
+	DPRINT("Deferred : relative byte %!'+B\n", sizeof(Mac), Mac) ;
+#if		(xpfSUPPORT_DATETIME == 1)
+	DPRINT("Deferred : %c %D %T (TSZ_t copy unaligned)\n", 'x', &sTSZ, &sTSZ) ;
+#endif
+	strcpy(Name, "reused") ;							// captured copies are output
+	memset(Mac, 0, sizeof(Mac)) ;
+	xPrintDeferredDrain(stdout, 0) ;
+#endif
+
+#if		(TEST_LOGLEVEL == 1) && (xpfSUPPORT_LOG_LEVELS == 1)
+	int		Evals = 0 ;
+	int		Level = xPrintLogLevel(xpfLOG_MODULE, xpfLEVEL_WARN) ;
+	LPRINT(ERROR, "Level  : ERROR shown %d\n", ++Evals) ;
+	LPRINT(WARN, "Level  : WARN shown %d\n", ++Evals) ;
+	LPRINT(INFO, "Level  : INFO suppressed %d\n", ++Evals) ;
+	LTRACK(DEBUG, "Level  : DEBUG suppressed %d\n", ++Evals) ;
+	printfx("Level  : evaluated %d suppressed %u\n", Evals, xPrintLogSuppressed(xpfLOG_MODULE, 1)) ;
+	xPrintLogLevel(xpfLOG_MODULE, Level) ;
+#endif
+
+#if		(TEST_RATELIMIT == 1) && (xpfSUPPORT_RATE_LIMIT == 1)
+	xprl_t	sRL = { 0 } ;
+	int		Pass = 0 ;
+	for (int Idx = 0; Idx < 25; ++Idx) if (xPrintRateCheck(&sRL, xpfRATE_PER_SEC, xpfRATE_BURST)) ++Pass ;
+	printfx("Rate   : %d of 25 passed, %u suppressed\n", Pass, sRL.Suppressed) ;
+	for (int Idx = 0; Idx < 3; ++Idx) RPRINT("Rate   : hot site %d\n", Idx) ;
+#endif
+
+#if		(TEST_ARRAY == 1) && (xpfSUPPORT_ARRAYS == 1)
+	int8_t		aI8[]	= { -128, -1, 0, 1, 127 } ;
+	uint16_t	aU16[]	= { 0, 255, 4096, 65535 } ;
+	int32_t		aI32[]	= { -2000000000, -1, 0, 1234567 } ;
+	uint64_t	aU64[]	= { 0ULL, 0xDEADBEEFCAFEULL, 18446744073709551615ULL } ;
+	float		aF32[]	= { -1.5f, 0.0f, 3.14159f } ;
+	double		aF64[]	= { 1e-3, 22000.0 / 7.0 } ;
+	printfx("Array  : I8  [%[5b, ]d]\n", aI8) ;
+	printfx("Array  : U16 [%[*h|]5u] [%[4h ]04x]\n", 4, aU16, aU16) ;
+	printfx("Array  : I32 [%[* ]'d] [%[*,]-*d]\n", 4, aI32, 4, 6, aI32) ;
+	printfx("Array  : U64 [%[3 ]llX] [%[2h ]J]\n", aU64, aU16) ;
+	printfx("Array  : F32 [%[3w ].2f] F64 [%[2; ]e]\n", aF32, aF64) ;
+	printfx("Array  : rejected [%[3]s] [%[3h]f] [%[*]c] %d\n", aU16, aU16, 2, aU16, 42) ;
+	xI8ArrayPrint("Array  : xI8ArrayPrint ", (uint8_t *) aU16, 8) ;
+#endif
+
+#if		(TEST_BATCH == 1) && (xpfSUPPORT_BATCH == 1)
+	xpb_t	sBatch = { .pvBase = sSensors, .psField = sSensorFields, .Stride = sizeof(sensor_t),
+						.Next = 0, .Count = 4, .Fields = 8 } ;
+	printfx("Batch  : %d chars\n", printfx_batch(TEST_BATCH_FMT, &sBatch)) ;
+	char	Chunk[64], Whole[256] ;
+	int		Len = 0 ;
+	sBatch.Next = 0 ;									// complete records per chunk
+	while (sBatch.Next < sBatch.Count) {
+		uint32_t First = sBatch.Next ;
+		int iRV = snprintfx_batch(Chunk, sizeof(Chunk), TEST_BATCH_FMT, &sBatch) ;
+		printfx("Batch  : chunk records %u->%u %d chars\n", First, sBatch.Next, iRV) ;
+		if (iRV <= 0) break ;
+		memcpy(Whole + Len, Chunk, iRV) ;
+		Len += iRV ;
+	}
+	char	Part[2][128] ;									// ranges as split between tasks
+	xpb_t	sLo = sBatch, sHi = sBatch ;
+	sLo.Next = 0 ; sLo.Count = 2 ;
+	sHi.Next = 2 ; sHi.Count = 4 ;
+	int		Lo = snprintfx_batch(Part[0], sizeof(Part[0]), TEST_BATCH_FMT, &sLo) ;
+	int		Hi = snprintfx_batch(Part[1], sizeof(Part[1]), TEST_BATCH_FMT, &sHi) ;
+	int		Same = (Lo + Hi == Len) && memcmp(Whole, Part[0], Lo) == 0 && memcmp(Whole + Lo, Part[1], Hi) == 0 ;
+	printfx("Batch  : chunked %s split\n", Same ? "==" : "!=") ;
+	sBatch.Next = 0 ;
+	printfx("Batch  : field mismatch %d, '*' width %d\n",
+		snprintfx_batch(Chunk, sizeof(Chunk), "%u %s", &sBatch),
+		snprintfx_batch(Chunk, sizeof(Chunk), "%*u,%s,%d,%04x,%.2f,%'u,%s,%[3h;]u", &sBatch)) ;
+	sBatch.Next = 0 ; sBatch.Count = 2 ;				// > xpfPROG_MAX_OPS, parsed per record
+	printfx("Batch  : wide %d chars\n", printfx_batch("|%u|%s|%d|%04x|%.2f|%'u|%s|%[3h;]u|\n", &sBatch)) ;
+#endif
+
+#if		(TEST_PACKED == 1) && (xpfSUPPORT_PACKED == 1)
+	{	// arguments packed as printfx.hpp does, each the size the conversion fetches, data referenced
+		static const char	TestPacked[] = "%*d|%s|%'llu|%.3f|%[3h,]u|%+B" ;
+		uint16_t	aU16[3] = { 1, 300, 65535 } ;
+		const char * pcStr = "packed" ;
+		int32_t		Wid = 6, I32 = -42, Len = 6 ;
+		uint64_t	U64 = 1234567890123ULL ;
+		double		F64 = 3.14159 ;
+		const void * pV ;
+		uint8_t		Pack[64], * pNow = Pack ;
+		memcpy(pNow, &Wid, sizeof(Wid)) ;		pNow += sizeof(Wid) ;
+		memcpy(pNow, &I32, sizeof(I32)) ;		pNow += sizeof(I32) ;
+		memcpy(pNow, &pcStr, sizeof(pcStr)) ;	pNow += sizeof(pcStr) ;
+		memcpy(pNow, &U64, sizeof(U64)) ;		pNow += sizeof(U64) ;
+		memcpy(pNow, &F64, sizeof(F64)) ;		pNow += sizeof(F64) ;
+		pV = aU16 ;
+		memcpy(pNow, &pV, sizeof(pV)) ;			pNow += sizeof(pV) ;
+		memcpy(pNow, &Len, sizeof(Len)) ;		pNow += sizeof(Len) ;
+		pV = pcStr ;
+		memcpy(pNow, &pV, sizeof(pV)) ;			pNow += sizeof(pV) ;
+		char	Packed[160], Native[160] ;
+		int		P = snprintfx_packed(Packed, sizeof(Packed), TestPacked, Pack) ;
+		int		N = snprintfx(Native, sizeof(Native), TestPacked, Wid, I32, pcStr, U64, F64, aU16, Len, pcStr) ;
+		printfx("Packed : %d/%d %s\n%s\n", P, N, (P == N && strcmp(Packed, Native) == 0) ? "==" : "!=", Packed) ;
+	}
+#endif
+
+#if		(TEST_UBUF == 1) && defined(ESP_PLATFORM)
+	{	// 16 byte ring, indices moved to 12 so the 2nd call wraps & the 3rd is truncated to fit
+		ubuf_t * psUB = psUBufCreate(NULL, NULL, 16, 0) ;
+		char	Ring[20], * pNow = Ring ;
+		int	W1 = uprintfx(psUB, "%s", "0123456789AB") ;
+		while (xUBufGetC(psUB) >= 0) ;
+		int	W2 = uprintfx(psUB, "%s", "abcdefghij") ;
+		int	W3 = uprintfx(psUB, "%d", 1234567890) ;
+		for (int cChr; (cChr = xUBufGetC(psUB)) >= 0; *pNow++ = cChr) ;
+		*pNow = 0 ;
+		printfx("UBuf   : %d/%d/%d [%s]\n", W1, W2, W3, Ring) ;
+		vUBufDestroy(psUB) ;
+	}
+#endif
+
+#if		(TEST_ASYNC == 1) && (xpfSUPPORT_ASYNC == 1)
+	{	// overfill the ring while holding printfx_lock(), the writer task waits for the lock so a
+		// queueing xpfASYNC_BLOCK producer would never get space. Then 1 call > xpfASYNC_REC_SIZE
+		xPrintAsyncStart(xpfASYNC_BLOCK) ;
+		printfx_lock() ;
+		for (int Idx = 0; Idx < (2 * xpfASYNC_RECORDS); ++Idx) printfx("Async  : locked %d\n", Idx) ;
+		printfx_unlock() ;
+		printfx("Async  : %*s|\n", xpfASYNC_REC_SIZE + 20, "not split") ;
+	}
+#endif
+}
+
+// ########################################### benchmarks ##########################################
+
+#define		BENCH_LITERAL	1
+#define		BENCH_PROGRAMS	1
+#define		BENCH_PARSE		1
+#define		BENCH_INTEGER	1
+#define		BENCH_FLOAT		1
+#define		BENCH_HEXDUMP	1
+#define		BENCH_HANDLE	1
+#define		BENCH_SOCKET	1
+#define		BENCH_FILE		1
+#define		BENCH_DEFERRED	1
+#define		BENCH_LOGLEVEL	1
+#define		BENCH_RATELIMIT	1
+#define		BENCH_ARRAY		1
+#define		BENCH_BATCH		1
+
+#define		BENCH_LOOPS		10000
+
+/**
+ * xBenchTicks() - free running cycle counter (Xtensa CCOUNT, x86 TSC) else nanoseconds
+ */
+static uint64_t xBenchTicks(void) {
+#ifdef	ESP_PLATFORM
+	return xthal_get_ccount() ;
+#elif	defined(__x86_64__) || defined(__i386__)
+	return __rdtsc() ;
+#else
+	struct timespec sTS ;
+	clock_gettime(CLOCK_MONOTONIC, &sTS) ;
+	return (uint64_t) sTS.tv_sec * 1000000000ULL + sTS.tv_nsec ;
+#endif
+}
+
+#define	BENCH_RUN(Label, Call)	{											\
+	uint64_t Tstart = xBenchTicks() ;										\
+	for (int32_t Loop = 0; Loop < BENCH_LOOPS; ++Loop) { Call ; }			\
+	uint32_t Ticks = (xBenchTicks() - Tstart) / BENCH_LOOPS ;				\
+	printfx("%-40s %'8u ticks/call\n", Label, Ticks) ;						\
+}
+
+#if		(BENCH_SOCKET == 1) && defined(ESP_PLATFORM)
+/* Loopback TCP connection, a separate task drains the receive side. Compares the previous one
+ * xNetWrite() per character sink against socprintfx() staging chunks sent with MSG_MORE */
+#define	BENCH_SOCK_LOOPS	2000
+
+static void vBenchSockDrain(void * pvPara) {
+	char	Buffer[256] ;
+	while (recv((int) pvPara, Buffer, sizeof(Buffer), 0) > 0) ;
+	close((int) pvPara) ;
+	vTaskDelete(NULL) ;
+}
+
+static int xBenchSockPerChar(xpc_t * psXPC, int cChr) {
+	char cBuf = cChr ;
+	return (xNetWrite(psXPC->psSock, &cBuf, sizeof(cBuf)) > 0) ? cChr : EOF ;
+}
+
+static int xBenchSockOld(netx_t * psSock, const char * format, ...) {
+	va_list vArgs ;
+	va_start(vArgs, format) ;
+	int	Fsav = psSock->flags ;
+	psSock->flags |= MSG_MORE ;
+	int iRV = xprintfx(xBenchSockPerChar, psSock, xpfMAXLEN_MAXVAL, format, vArgs) ;
+	psSock->flags = Fsav ;
+	va_end(vArgs) ;
+	return iRV ;
+}
+
+#define	BENCH_SOCK(Label, Call)	{												\
+	uint64_t Bytes = 0, Tstart = esp_timer_get_time() ;							\
+	for (int32_t Loop = 0; Loop < BENCH_SOCK_LOOPS; ++Loop) {					\
+		int iRV = Call ;														\
+		if (iRV < 0) break ;													\
+		Bytes += iRV ;															\
+	}																			\
+	uint64_t uSec = esp_timer_get_time() - Tstart ;								\
+	printfx("%-40s %'8llu bytes/sec\n", Label, (Bytes * 1000000ULL) / (uSec ? uSec : 1)) ;	\
+}
+
+static void vBenchSocket(void) {
+	struct sockaddr_in sSA = { .sin_family = AF_INET, .sin_addr.s_addr = htonl(INADDR_LOOPBACK) } ;
+	socklen_t	Len = sizeof(sSA) ;
+	int	sL = socket(AF_INET, SOCK_STREAM, 0) ;
+	if (sL < 0) return ;
+	if (bind(sL, (struct sockaddr *) &sSA, sizeof(sSA)) == 0 && listen(sL, 1) == 0 &&
+		getsockname(sL, (struct sockaddr *) &sSA, &Len) == 0) {
+		netx_t	sSock = { 0 } ;
+		sSock.sd	= socket(AF_INET, SOCK_STREAM, 0) ;
+		if (sSock.sd >= 0 && connect(sSock.sd, (struct sockaddr *) &sSA, sizeof(sSA)) == 0) {
+			int	sA = accept(sL, NULL, NULL) ;
+			if (sA >= 0 && xTaskCreate(vBenchSockDrain, "drain", 2048, (void *) sA, tskIDLE_PRIORITY + 1, NULL) == pdPASS) {
+				#define	BENCH_SOCK_FMT	"HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: %d\r\n\r\nsensor=%s value=%'d\r\n"
+				BENCH_SOCK("socket: per char xNetWrite",
+					xBenchSockOld(&sSock, BENCH_SOCK_FMT, 27, "temp", Loop)) ;
+				BENCH_SOCK("socket: socprintfx staged",
+					socprintfx(&sSock, BENCH_SOCK_FMT, 27, "temp", Loop)) ;
+			}
+		}
+		if (sSock.sd >= 0) close(sSock.sd) ;				// drain task sees EOF & exits
+	}
+	close(sL) ;
+}
+#endif
+
+void	vPrintfBenchmark(void) {
+	char	Buffer[256] ;
+	printfx("\nbenchmarks (%d loops)\n", BENCH_LOOPS) ;
+#if		(BENCH_LITERAL == 1)
+	BENCH_RUN("literal: _TRACK_ prefix + 1 value",
+		snprintfx(Buffer, sizeof(Buffer), _TRACK_("value=%d"), __FUNCTION__, __LINE__, 12345)) ;
+	BENCH_RUN("literal: 120 chars + 1 value",
+		snprintfx(Buffer, sizeof(Buffer), "Sensor sample completed, averaging window closed, results queued for upload to the cloud service, value=%d units\n", 12345)) ;
+	BENCH_RUN("literal: 200 chars, no conversion",
+		snprintfx(Buffer, sizeof(Buffer), "0---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0\n")) ;
+#endif
+#if		(BENCH_PROGRAMS == 1)
+	BENCH_RUN("parsed: mixed conversions",
+		snprintfx(Buffer, sizeof(Buffer), "%-8s|%+'10d|%08X|%.3f|%*.*s\n", "name", 1234567, 0xDEADBEEF, 3.14159, 10, 4, "truncated")) ;
+	BENCH_RUN("cached: mixed conversions",
+		snprintfx_cached(Buffer, sizeof(Buffer), "%-8s|%+'10d|%08X|%.3f|%*.*s\n", "name", 1234567, 0xDEADBEEF, 3.14159, 10, 4, "truncated")) ;
+	char Buf2[256] ;
+	snprintfx(Buf2, sizeof(Buf2), "%-8s|%+'10d|%08X|%.3f|%*.*s\n", "name", 1234567, 0xDEADBEEF, 3.14159, 10, 4, "truncated") ;
+	printfx("cached %s parsed\n", strcmp(Buffer, Buf2) ? "!=" : "==") ;
+	#define	TEST_WIDE_FMT	"%d %d %d %d %d %d %d %d %d %d\n"		// > xpfPROG_MAX_OPS, parsed
+	BENCH_RUN("cached: 10 conversions, not compilable",
+		snprintfx_cached(Buffer, sizeof(Buffer), TEST_WIDE_FMT, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10)) ;
+	snprintfx(Buf2, sizeof(Buf2), TEST_WIDE_FMT, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10) ;
+	printfx("cached %s parsed (%s)\n", strcmp(Buffer, Buf2) ? "!=" : "==", psPrintProgFind(TEST_WIDE_FMT) ? "program" : "parser") ;
+	xpcs_t	sPS ;
+	vPrintProgStats(&sPS) ;
+	printfx("cache  : %u/%u slots, %u hits, %u misses\n", sPS.Slots, sPS.Size, sPS.Hits, sPS.Misses) ;
+#endif
+#if		(BENCH_PARSE == 1) && (xpfSUPPORT_PROGRAMS == 1)
+	xpp_t	sProg ;
+	BENCH_RUN("parse: 6 plain specifiers",
+		xPrintCompile(&sProg, "%d %u %x %s %c %p")) ;
+	BENCH_RUN("parse: 6 modifier heavy specifiers",
+		xPrintCompile(&sProg, "%-+'08d %#010llX %!'+-*.*s %' 12.4E % -8G %-#'0*M")) ;
+#endif
+#if		(BENCH_INTEGER == 1)
+	BENCH_RUN("integer: %d",
+		snprintfx(Buffer, sizeof(Buffer), "%d", -123456789)) ;
+	BENCH_RUN("integer: %llu",
+		snprintfx(Buffer, sizeof(Buffer), "%llu", 18446744073709551615ULL)) ;
+	BENCH_RUN("integer: %x",
+		snprintfx(Buffer, sizeof(Buffer), "%x", 0xDEADBEEF)) ;
+	BENCH_RUN("integer: %'lld",
+		snprintfx(Buffer, sizeof(Buffer), "%'lld", -9223372036854775807LL)) ;
+#endif
+#if		(BENCH_FLOAT == 1) && (xpfSUPPORT_IEEE754 == 1)
+	static double dRandom[256], dTypical[256] ;
+	uint64_t Seed = 88172645463325252ULL ;
+	for (int Idx = 0; Idx < 256; ++Idx) {				// xorshift, random bit patterns over full range
+		x64_t X64 ;
+		do {
+			Seed ^= Seed << 13 ; Seed ^= Seed >> 7 ; Seed ^= Seed << 17 ;
+			X64.u64 = Seed ;
+		} while (isnan(X64.f64) || isinf(X64.f64)) ;
+		dRandom[Idx]	= X64.f64 ;
+		dTypical[Idx]	= (double) (Seed % 100000000ULL) / 1000.0 ;
+	}
+	BENCH_RUN("float: %e random",
+		snprintfx(Buffer, sizeof(Buffer), "%e", dRandom[Loop & 255])) ;
+	BENCH_RUN("float: %.15e random",
+		snprintfx(Buffer, sizeof(Buffer), "%.15e", dRandom[Loop & 255])) ;
+	BENCH_RUN("float: %g random",
+		snprintfx(Buffer, sizeof(Buffer), "%g", dRandom[Loop & 255])) ;
+	BENCH_RUN("float: %f 0 -> 100000",
+		snprintfx(Buffer, sizeof(Buffer), "%f", dTypical[Loop & 255])) ;
+	BENCH_RUN("float: %.3f 0 -> 100000",
+		snprintfx(Buffer, sizeof(Buffer), "%.3f", dTypical[Loop & 255])) ;
+	BENCH_RUN("float: %!g random (shortest)",
+		snprintfx(Buffer, sizeof(Buffer), "%!g", dRandom[Loop & 255])) ;
+#endif
+#if		(BENCH_HEXDUMP == 1) && (xpfSUPPORT_HEXDUMP == 1)
+	static	char	DumpBuf[6144] ;
+	static	uint8_t	DumpSrc[1024] ;
+	for (int32_t Idx = 0; Idx < (int32_t) sizeof(DumpSrc); ++Idx) DumpSrc[Idx] = Idx * 37 ;
+	BENCH_RUN("hexdump: 1KB %+B",
+		snprintfx(DumpBuf, sizeof(DumpBuf), "%+B", sizeof(DumpSrc), DumpSrc)) ;
+	BENCH_RUN("hexdump: 1KB %'+B",
+		snprintfx(DumpBuf, sizeof(DumpBuf), "%'+B", sizeof(DumpSrc), DumpSrc)) ;
+	BENCH_RUN("hexdump: 1KB %!'+llW (unaligned)",
+		snprintfx(DumpBuf, sizeof(DumpBuf), "%!'+llW", sizeof(DumpSrc) - 1, DumpSrc + 1)) ;
+	static	uint8_t	DumpZero[16384] ;
+	BENCH_RUN("hexdump: 16KB zeroed %!=+B (squeezed)",
+		snprintfx(DumpBuf, sizeof(DumpBuf), "%!=+B", sizeof(DumpZero), DumpZero)) ;
+	#if		(xpfSUPPORT_HEXDUMP == 1) && (xpfSUPPORT_HEXDUMP_MT == 1) && defined(__linux__)
+	static	uint8_t	DumpBig[4 << 20] ;					// single call timed, 4MB => ~18.6MB
+	static	char	DumpOut[20 << 20] ;
+	for (int32_t Idx = 0; Idx < (int32_t) sizeof(DumpBig); ++Idx) DumpBig[Idx] = Idx * 37 ;
+	for (int Threads = 1; Threads <= 8; Threads *= 2) {
+		char	Label[48] ;
+		uint64_t Tstart = xBenchTicks() ;
+		int64_t	Len = xPrintHexDumpMT(DumpOut, sizeof(DumpOut), "%'+B", DumpBig, sizeof(DumpBig), Threads) ;
+		uint64_t Ticks = xBenchTicks() - Tstart ;
+		snprintfx(Label, sizeof(Label), "hexdump: 4MB %%'+B %d thread(s)", Threads) ;
+		printfx("%-40s %'8llu ticks/MB (%lld chars)\n", Label, Ticks / (sizeof(DumpBig) >> 20), Len) ;
+	}
+	#endif
+#endif
+#if		(BENCH_HANDLE == 1) && !defined(ESP_PLATFORM)
+	int	fd = open("/dev/null", O_WRONLY) ;
+	if (fd >= 0) {
+		static	xpfb_t	sFB ;
+		vPrintFdInit(&sFB, fd) ;
+		BENCH_RUN("handle: 120 chars + 1 value",
+			dprintfx(fd, "Sensor sample completed, averaging window closed, results queued for upload to the cloud service, value=%d units\n", 12345)) ;
+		BENCH_RUN("handle: %s 200 chars + 1 value",
+			dprintfx(fd, "%s value=%d\n", "0---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0", 12345)) ;
+		BENCH_RUN("handle: buffered 120 chars + 1 value",
+			bdprintfx(&sFB, "Sensor sample completed, averaging window closed, results queued for upload to the cloud service, value=%d units\n", 12345)) ;
+		xPrintFdFlush(&sFB) ;
+		close(fd) ;
+	}
+#endif
+#if		(BENCH_FILE == 1)
+	FILE *	fp = fopen("/dev/null", "w") ;
+	if (fp) {
+		BENCH_RUN("file: 120 chars + 1 value",
+			fprintfx(fp, "Sensor sample completed, averaging window closed, results queued for upload to the cloud service, value=%d units\n", 12345)) ;
+		fclose(fp) ;
+	}
+#endif
+#if		(BENCH_DEFERRED == 1) && (xpfSUPPORT_DEFERRED == 1)
+	FILE *	fpNull = fopen("/dev/null", "w") ;
+	if (fpNull) {										// only capture timed, drained every 32 records
+		uint64_t Ticks = 0 ;
+		for (int32_t Loop = 0; Loop < BENCH_LOOPS; ++Loop) {
+			uint64_t Tstart = xBenchTicks() ;
+			DTRACK("value=%d state=%s", Loop, "idle") ;
+			Ticks += xBenchTicks() - Tstart ;
+			if ((Loop & 31) == 31) xPrintDeferredDrain(fpNull, 0) ;
+		}
+		printfx("%-40s %'8u ticks/call\n", "deferred: _TRACK_ + 2 values captured", (uint32_t) (Ticks / BENCH_LOOPS)) ;
+		BENCH_RUN("deferred: same formatted to buffer",
+			snprintfx(Buffer, sizeof(Buffer), _TRACK_("value=%d state=%s"), Loop, "idle")) ;
+		fclose(fpNull) ;
+	}
+#endif
+#if		(BENCH_LOGLEVEL == 1) && (xpfSUPPORT_LOG_LEVELS == 1)
+	BENCH_RUN("level: LTRACK below module level",
+		LTRACK(VERBOSE, "value=%d state=%s", Loop, "idle")) ;
+	xPrintLogSuppressed(xpfLOG_MODULE, 1) ;
+#endif
+#if		(BENCH_RATELIMIT == 1) && (xpfSUPPORT_RATE_LIMIT == 1)
+	xprl_t	sBench = { 0 } ;							// suppressed after the first burst
+	BENCH_RUN("rate: call site check",
+		xPrintRateCheck(&sBench, xpfRATE_PER_SEC, xpfRATE_BURST)) ;
+#endif
+#if		(BENCH_ARRAY == 1) && (xpfSUPPORT_ARRAYS == 1)
+	static	uint8_t	aU8[32] ;
+	for (int Idx = 0; Idx < (int) sizeof(aU8); ++Idx) aU8[Idx] = Idx * 7 ;
+	BENCH_RUN("array: 32x U8 per element calls",
+		for (int Len = 0, Idx = 0; Idx < (int) sizeof(aU8); ++Idx) Len += snprintfx(Buffer + Len, sizeof(Buffer) - Len, " %u", aU8[Idx])) ;
+	BENCH_RUN("array: 32x U8 %[32b ]u",
+		snprintfx(Buffer, sizeof(Buffer), "%[32b ]u", aU8)) ;
+#endif
+#if		(BENCH_BATCH == 1) && (xpfSUPPORT_BATCH == 1)
+	static	char	BatchBuf[2048] ;
+	static	sensor_t aRows[32] ;
+	for (int Idx = 0; Idx < 32; ++Idx) aRows[Idx] = sSensors[Idx & 3] ;
+	BENCH_RUN("batch: 32 records, snprintfx per record",
+		for (int Len = 0, Idx = 0; Idx < 32; ++Idx)
+			Len += snprintfx(BatchBuf + Len, sizeof(BatchBuf) - Len, "%u,%s,%d,%04x,%.2f,%'u,%s,%u;%u;%u\n",
+				aRows[Idx].Id, aRows[Idx].pcName, aRows[Idx].Temp, (uint16_t) aRows[Idx].Temp, aRows[Idx].Humid,
+				aRows[Idx].Count, aRows[Idx].Unit, aRows[Idx].Hist[0], aRows[Idx].Hist[1], aRows[Idx].Hist[2])) ;
+	xpb_t	sRows = { .pvBase = aRows, .psField = sSensorFields, .Stride = sizeof(sensor_t), .Count = 32, .Fields = 8 } ;
+	BENCH_RUN("batch: 32 records, snprintfx_batch",
+		sRows.Next = 0 ; snprintfx_batch(BatchBuf, sizeof(BatchBuf), TEST_BATCH_FMT, &sRows)) ;
+#endif
+#if		(BENCH_SOCKET == 1) && defined(ESP_PLATFORM)
+	vBenchSocket() ;
+#endif
 }
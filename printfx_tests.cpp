@@ -0,0 +1,107 @@
+/*
+ * Copyright 2021 Andre M Maree / KSS Technologies (Pty) Ltd.
+ *
+ * printfx_tests.cpp - printfx.hpp type safe front end, every sink against the C functions
+ *
+ */
+
+#include	"hal_variables.h"
+#include	"printfx.hpp"
+
+#include	<cstdio>
+#include	<cstring>
+#include	<cfloat>								// DBL_MAX
+#include	<climits>								// INT_MIN
+#include	<cmath>									// INFINITY, NAN
+
+#include	<unistd.h>								// STDOUT_FILENO
+
+// ##################################### functional tests ##########################################
+
+#define		TEST_CXX_SINKS	1
+#define		TEST_CXX_BOUND	1
+
+static const char * pcCxxSame(int C, int N, const char * pcC, const char * pcN) {
+	return (C == N && strcmp(pcC, pcN) == 0) ? "==" : "!=" ;
+}
+
+/**
+ * xCxxBound() - worst case values rendered into a buffer of exactly bufsize<F>, the output must
+ * 		match snprintfx() completely (ie not truncated) and not exceed bound<F>
+ * \return	1 if OK else 0, failure reported
+ */
+template <xpf::xpfc_t F, typename... Args>
+static int xCxxBound(Args... args) {
+	char	Buf[printfx::bufsize<F>], Native[1024] ;
+	int		C = printfx::emit<F>(Buf, args...) ;
+	int		N = snprintfx(Native, sizeof(Native), F.Str, args...) ;
+	if (C == N && strcmp(Buf, Native) == 0 && (size_t) N <= printfx::bound<F>) return 1 ;
+	printfx("C++    : bound [%s] %d/%d > %u\n%s\n", F.Str, C, N, (unsigned) printfx::bound<F>, Native) ;
+	return 0 ;
+}
+
+extern "C" void	vPrintfCxxTest(void) {
+#if		(TEST_CXX_SINKS == 1)
+	{	// string sinks compared with snprintfx(), dump length from sizeof() as size_t
+		uint8_t		aDump[24] ;
+		uint16_t	aU16[3] = { 1, 300, 65535 } ;
+		for (size_t Idx = 0; Idx < sizeof(aDump); ++Idx) aDump[Idx] = Idx * 11 ;
+		char		Native[192], Cxx[192] ;
+		int N = snprintfx(Native, sizeof(Native), "%d|%'llu|%.2f|%s|%+B", -42, 1234567890123ULL, 3.14159, "cxx", (int) sizeof(aDump), aDump) ;
+		int C = printfx::print(Cxx, "%d|%'llu|%.2f|%s|%+B", -42, 1234567890123ULL, 3.14159, "cxx", sizeof(aDump), aDump) ;
+		printfx("C++    : char[] %d/%d %s\n%s\n", C, N, pcCxxSame(C, N, Cxx, Native), Cxx) ;
+
+		N = snprintfx(Native, 8, "%s %d", "truncated", 12345) ;
+		C = printfx::print(printfx::buffer { Cxx, 8 }, "%s %d", "truncated", 12345) ;
+		printfx("C++    : buffer %d/%d %s [%s]\n", C, N, pcCxxSame(C, N, Cxx, Native), Cxx) ;
+
+		xpc_t	sXPC ;
+		sXPC.handler	= NULL ;
+		sXPC.writer		= xPrintToStringSpan ;
+		sXPC.pStr		= Cxx ;
+		sXPC.f.maxlen	= sizeof(Cxx) ;
+		sXPC.f.curlen	= 0 ;
+		N = snprintfx(Native, sizeof(Native), "%[3h,]u %'M", aU16, aDump) ;
+		C = printfx::print(&sXPC, "%[3h,]u %'M", aU16, aDump) ;
+		Cxx[C] = 0 ;
+		printfx("C++    : xpc_t* %d/%d %s [%s]\n", C, N, pcCxxSame(C, N, Cxx, Native), Cxx) ;
+	}
+	{	// stream sinks, output only
+		printfx::print(printfx::out, "C++    : out %s %llu\n", "stdout", sizeof(uint64_t)) ;
+		printfx::print(stdout, "C++    : FILE* %.3f %c\n", 1.25, 'F') ;
+		fflush(stdout) ;
+		printfx::print(STDOUT_FILENO, "C++    : fd %u %#x\n", 3u, 255) ;
+	}
+#endif
+
+#if		(TEST_CXX_BOUND == 1)
+	{	// widest value of each conversion & modifier, signs, grouping, padding & precision
+		int		Pass = 0, Count = 0 ;
+		Pass += xCxxBound<"%d|%i|%u|%x|%X|%o|%c">(INT_MIN, INT_MAX, UINT_MAX, UINT_MAX, 0xABCDEFu, UINT_MAX, 'Z') ;	++Count ;
+		Pass += xCxxBound<"%'d|%'+u|%+x|%+o|%'lld|%'llu|%+llx|%#llo">(INT_MIN, UINT_MAX, UINT_MAX, UINT_MAX, INT64_MIN, UINT64_MAX, UINT64_MAX, UINT64_MAX) ;	++Count ;
+		Pass += xCxxBound<"%20d|%-20u|%020x|%+020d|%.3d|%8.3u|%'+026lld">(INT_MIN, UINT_MAX, 0xABCu, -5, 123456, 987654u, INT64_MIN) ;	++Count ;
+	#if		(xpfSUPPORT_IEEE754 == 1)
+		Pass += xCxxBound<"%f|%'f|%e|%E|%g|%G">(-DBL_MAX, -DBL_MAX, -DBL_MAX, -DBL_TRUE_MIN, -DBL_MAX, -DBL_TRUE_MIN) ;	++Count ;
+		Pass += xCxxBound<"%.20f|%+.15e|%.10g|%'.8g|%#g|%30.3f">(-DBL_TRUE_MIN, -1.7e-308, -9999999999.5, -99999999.5, 0.0001, 1.0) ;	++Count ;
+		Pass += xCxxBound<"%!f|%!e|%!g|%!'g|%f|%e">(-DBL_MAX, -DBL_MAX, -1e-5, -123456.7, -INFINITY, NAN) ;	++Count ;
+	#endif
+	#if		(xpfSUPPORT_FIXEDPOINT == 1)
+		Pass += xCxxBound<"%q|%'+Q|%'.15llq|%-30.4llQ">(0, INT_MIN, 3, INT_MIN, 19, INT64_MIN, 0, INT64_MIN) ;	++Count ;
+	#endif
+	#if		(xpfSUPPORT_IP_ADDR == 1) && (xpfSUPPORT_MAC_ADDR == 1)
+		uint8_t	aMac[6] = { 0xFF, 0xEE, 0xDD, 0xCC, 0xBB, 0xAA } ;
+		Pass += xCxxBound<"%I|%#I|%-I|%20I|%m|%'M|%#m|%20m">(0xC0A80101u, 0xFFFFFFFFu, 0x01010101u, 0xFFFFFFFFu, aMac, aMac, aMac, aMac) ;	++Count ;
+	#endif
+	#if		(xpfSUPPORT_BINARY == 1)
+		Pass += xCxxBound<"%J|%'J|%llJ|%12J|%'40J|%-70llJ">(UINT_MAX, UINT_MAX, UINT64_MAX, UINT_MAX, UINT_MAX, UINT64_MAX) ;	++Count ;
+	#endif
+	#if		(xpfSUPPORT_DATETIME == 1)
+		TSZ_t	sTSZ = { 253402300799999999ULL, NULL } ;	// 9999-12-31 23:59:59.999999
+		Pass += xCxxBound<"%R|%#R|%.6R|%#.3R|%!.6R|%!'.6R|%r|%!r">(sTSZ.usecs, sTSZ.usecs, sTSZ.usecs, sTSZ.usecs, 99ULL * 86400000000ULL - 1, 1000ULL * 86401001000ULL, UINT_MAX, 49710u * 86400u) ;	++Count ;
+		Pass += xCxxBound<"%D|%T|%Z|%.6T|%.3Z|%#Z">(&sTSZ, &sTSZ, &sTSZ, &sTSZ, &sTSZ, &sTSZ) ;	++Count ;
+	#endif
+		Pass += xCxxBound<"%.5s|%10.3s|%-8.20s|%C|%p">("string", "string", "string", 0xFFFFFFFFu, (void *) UINTPTR_MAX) ;	++Count ;
+		printfx("C++    : bound %d/%d formats within bufsize & bound\n", Pass, Count) ;
+	}
+#endif
+}